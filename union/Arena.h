@@ -0,0 +1,183 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "CoreTemplates.h"
+
+namespace vex::memory
+{
+	// bump allocator over a list of blocks: an allocation is an align + add, nothing is freed one by one.
+	// GetMarker/Rewind (or ArenaScope) release everything allocated after the marker, Reset releases all.
+	// blocks are kept across Rewind/Reset, so a per frame or per request arena stops touching malloc
+	// once it has seen its peak. New<T> does not register destructors: objects that own resources
+	// must be destroyed by the caller before their memory is rewound.
+	struct LinearArena
+	{
+		static constexpr size_t kDefaultBlockSize = 64 * 1024;
+
+		struct Marker
+		{
+			size_t Block = 0;
+			size_t Offset = 0;
+		};
+
+		explicit LinearArena(size_t blockSize = kDefaultBlockSize) : BlockSize(blockSize) {}
+		~LinearArena() { Release(); }
+
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		void* Allocate(size_t size, size_t align = alignof(std::max_align_t))
+		{
+			if (Current < Blocks.size())
+			{
+				if (void* ptr = TryBump(Blocks[Current], size, align))
+					return ptr;
+			}
+			return AllocateSlow(size, align);
+		}
+
+		// storage for the largest of Types, aligned for the strictest of them
+		template <typename... Types>
+		void* AllocateFor()
+		{
+			return Allocate(MaxSizeOf<Types...>(), MaxAlignOf<Types...>());
+		}
+
+		template <typename T>
+		T* AllocateArray(size_t count)
+		{
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		template <typename T, typename... TArgs>
+		T* New(TArgs&&... args)
+		{
+			return new (Allocate(sizeof(T), alignof(T))) T(std::forward<TArgs>(args)...);
+		}
+
+		Marker GetMarker() const noexcept { return Marker{Current, Offset}; }
+
+		// frees everything allocated after marker was taken
+		void Rewind(Marker marker) noexcept
+		{
+			Current = marker.Block;
+			Offset = marker.Offset;
+		}
+
+		void Reset() noexcept { Rewind(Marker{}); }
+
+		// returns every block to the system
+		void Release() noexcept
+		{
+			for (Block& block : Blocks)
+				::operator delete(block.Data, std::align_val_t{kBlockAlign});
+			Blocks.clear();
+			Current = 0;
+			Offset = 0;
+		}
+
+		size_t BytesReserved() const noexcept
+		{
+			size_t total = 0;
+			for (const Block& block : Blocks)
+				total += block.Size;
+			return total;
+		}
+
+	private:
+		struct Block
+		{
+			byte* Data = nullptr;
+			size_t Size = 0;
+		};
+
+		static constexpr size_t kBlockAlign = 64;
+
+		void* TryBump(const Block& block, size_t size, size_t align)
+		{
+			const uintptr_t base = (uintptr_t)block.Data;
+			const uintptr_t aligned = (base + Offset + align - 1) & ~(uintptr_t)(align - 1);
+			if (aligned + size > base + block.Size)
+				return nullptr;
+			Offset = aligned + size - base;
+			return (void*)aligned;
+		}
+
+		// moves to the next kept block, replacing it if it cannot hold size, or appends a new one
+		void* AllocateSlow(size_t size, size_t align)
+		{
+			const size_t needed = size + (align > kBlockAlign ? align : 0);
+			size_t next = Blocks.empty() ? 0 : Current + 1;
+			if (next < Blocks.size() && Blocks[next].Size < needed)
+			{
+				::operator delete(Blocks[next].Data, std::align_val_t{kBlockAlign});
+				Blocks[next] = NewBlock(needed);
+			}
+			else if (next == Blocks.size())
+			{
+				Blocks.push_back(NewBlock(needed));
+			}
+			Current = next;
+			Offset = 0;
+			return TryBump(Blocks[Current], size, align);
+		}
+
+		Block NewBlock(size_t needed) const
+		{
+			const size_t size = needed > BlockSize ? needed : BlockSize;
+			return Block{static_cast<byte*>(::operator new(size, std::align_val_t{kBlockAlign})), size};
+		}
+
+		std::vector<Block> Blocks;
+		size_t Current = 0;
+		size_t Offset = 0;
+		size_t BlockSize;
+	};
+
+	// rewinds the arena to where it was when the scope was entered
+	struct ArenaScope
+	{
+		explicit ArenaScope(LinearArena& arena) : Arena(arena), Mark(arena.GetMarker()) {}
+		~ArenaScope() { Arena.Rewind(Mark); }
+
+		ArenaScope(const ArenaScope&) = delete;
+		ArenaScope& operator=(const ArenaScope&) = delete;
+
+	private:
+		LinearArena& Arena;
+		LinearArena::Marker Mark;
+	};
+
+	// one arena per thread for temporaries that never leave it, typically wrapped in an ArenaScope
+	inline LinearArena& ThreadArena()
+	{
+		thread_local LinearArena arena;
+		return arena;
+	}
+
+	// std::pmr view of a LinearArena: deallocate is a no-op, memory comes back on Rewind/Reset.
+	//	ArenaResource resource(arena);
+	//	std::pmr::vector<vex::Union<int, float>> values(&resource);
+	struct ArenaResource : std::pmr::memory_resource
+	{
+		explicit ArenaResource(LinearArena& arena) : Arena(arena) {}
+
+		LinearArena& GetArena() const noexcept { return Arena; }
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override { return Arena.Allocate(bytes, alignment); }
+		void do_deallocate(void*, size_t, size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		LinearArena& Arena;
+	};
+} // namespace vex::memory
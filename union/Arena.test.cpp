@@ -0,0 +1,126 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for Arena.h, from the repository root:
+//	g++ -std=c++20 -pthread -I. union/Arena.test.cpp -o arena_test && ./arena_test
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Arena.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using vex::memory::LinearArena;
+
+namespace
+{
+	bool IsAligned(const void* ptr, size_t align) { return ((uintptr_t)ptr & (align - 1)) == 0; }
+
+	void CheckAlignment()
+	{
+		LinearArena arena(1024);
+		u32 aligned = 0, total = 0;
+		for (size_t align : {1, 2, 4, 8, 16, 32, 64, 128, 4096})
+		{
+			for (size_t size : {1, 3, 17, 100})
+			{
+				void* ptr = arena.Allocate(size, align);
+				aligned += IsAligned(ptr, align);
+				std::memset(ptr, 0xab, size); // ASan reports a block overrun here
+				++total;
+			}
+		}
+		VEX_CHECK(aligned == total);
+
+		struct alignas(32) Wide
+		{
+			float Lanes[8];
+		};
+		VEX_CHECK(IsAligned(arena.AllocateFor<char, Wide, double>(), 32));
+		double* values = arena.AllocateArray<double>(10);
+		VEX_CHECK(IsAligned(values, alignof(double)));
+		values[9] = 1.0;
+	}
+
+	void CheckRewind()
+	{
+		LinearArena arena(256);
+		arena.Allocate(100);
+		const LinearArena::Marker marker = arena.GetMarker();
+		std::vector<void*> first;
+		for (int i = 0; i < 20; ++i)
+			first.push_back(arena.Allocate(48, 16));
+		const size_t peak = arena.BytesReserved();
+
+		// the same sequence after a rewind lands on the same addresses, in blocks that were kept
+		arena.Rewind(marker);
+		u32 same = 0;
+		for (int i = 0; i < 20; ++i)
+			same += arena.Allocate(48, 16) == first[i];
+		VEX_CHECK(same == 20);
+		VEX_CHECK(arena.BytesReserved() == peak);
+
+		{
+			vex::memory::ArenaScope scope(arena);
+			arena.Allocate(64);
+		}
+		VEX_CHECK(arena.Allocate(48, 16) != first[0]);
+
+		arena.Reset();
+		// larger than a block: the kept block is replaced by one that fits
+		char* big = static_cast<char*>(arena.Allocate(1000));
+		big[999] = 1;
+		VEX_CHECK(arena.BytesReserved() >= peak - 256 + 1000);
+
+		int* counter = arena.New<int>(41);
+		VEX_CHECK(++*counter == 42);
+		arena.Release();
+		VEX_CHECK(arena.BytesReserved() == 0);
+		VEX_CHECK(*arena.New<int>(7) == 7);
+	}
+
+	void CheckResource()
+	{
+		LinearArena arena;
+		vex::memory::ArenaResource resource(arena);
+		{
+			std::pmr::vector<int> values(&resource);
+			for (int i = 0; i < 10000; ++i)
+				values.push_back(i);
+			VEX_CHECK(values[9999] == 9999);
+			std::pmr::string text("a string long enough to leave the small buffer", &resource);
+			VEX_CHECK(text.size() > 40);
+		}
+		VEX_CHECK(arena.BytesReserved() > 10000 * sizeof(int));
+		VEX_CHECK(&resource.GetArena() == &arena && resource.is_equal(resource));
+	}
+
+	void CheckThreadArena()
+	{
+		void* mainArena = &vex::memory::ThreadArena();
+		void* otherArena = nullptr;
+		std::thread([&] { otherArena = &vex::memory::ThreadArena(); }).join();
+		VEX_CHECK(mainArena != otherArena && mainArena == &vex::memory::ThreadArena());
+	}
+} // namespace
+
+int main()
+{
+	CheckAlignment();
+	CheckRewind();
+	CheckResource();
+	CheckThreadArena();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
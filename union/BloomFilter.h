@@ -0,0 +1,283 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <cassert>
+#include <cmath>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VEX_BLOOM_AVX2 1
+#else
+#define VEX_BLOOM_AVX2 0
+#endif
+
+#include "CoreTemplates.h"
+#include "HashUtils.h"
+
+namespace vex
+{
+	namespace sketch_impl
+	{
+		// splitmix64 finalizer, widens 32 bit policy hashes so block and bit selection do not share bits
+		inline constexpr u64 Mix64(u64 x)
+		{
+			x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+			x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+			return x ^ (x >> 31);
+		}
+
+		// policies with Hash64 (SHash_WY, SHash_Fast) are used directly, the rest go through HashValue
+		template <typename THashPolicy, typename T>
+		inline u64 Hash64(const T& key)
+		{
+			if constexpr (requires { THashPolicy::Hash64(std::string_view{}); })
+			{
+				if constexpr (std::is_convertible_v<const T&, std::string_view>)
+					return THashPolicy::Hash64(std::string_view(key));
+				else if constexpr (traits::IsByteValue<T>)
+					return THashPolicy::Hash64(&key, sizeof(T));
+			}
+			return Mix64((u32)util::HashValue<THashPolicy>(key));
+		}
+
+		// uniform [0, range) from 32 random bits without a divide
+		inline u32 FastRange(u32 hash, u32 range) { return (u32)(((u64)hash * range) >> 32); }
+	} // namespace sketch_impl
+
+	// register blocked Bloom filter: a key sets 8 bits inside one 64 byte block, one bit in each
+	// of its 64 bit words, so an insert or a query touches a single cache line.
+	// the high half of the 64 bit hash picks the block, the low half times 8 odd salts picks the bits.
+	// no false negatives. filters of the same size built on different threads combine with Merge.
+	template <typename THashPolicy = util::SHash_MURMUR>
+	struct BlockedBloomFilter
+	{
+		static constexpr u32 kWordsPerBlock = 8;
+
+		struct alignas(64) Block
+		{
+			u64 Words[kWordsPerBlock];
+		};
+
+		// always at least one block, the probes index Blocks without checking
+		BlockedBloomFilter() : BlockedBloomFilter(1u) {}
+		explicit BlockedBloomFilter(u32 blockCount) : Blocks(blockCount ? blockCount : 1, Block{}) {}
+		// smallest filter whose expected false positive rate at expectedKeys is at most falsePositiveRate
+		BlockedBloomFilter(size_t expectedKeys, double falsePositiveRate)
+			: BlockedBloomFilter(BlocksFor(expectedKeys, falsePositiveRate))
+		{
+		}
+
+		template <typename T>
+		void Insert(const T& key)
+		{
+			InsertHash(sketch_impl::Hash64<THashPolicy>(key));
+		}
+		template <typename T>
+		bool MayContain(const T& key) const
+		{
+			return MayContainHash(sketch_impl::Hash64<THashPolicy>(key));
+		}
+
+		// pre-hashed entry points, hash is a 64 bit value as produced by sketch_impl::Hash64
+		void InsertHash(u64 hash)
+		{
+			assert(!Blocks.empty()); // a moved from filter
+			Block& block = Blocks[sketch_impl::FastRange((u32)(hash >> 32), (u32)Blocks.size())];
+#if VEX_BLOOM_AVX2
+			__m256i lo, hi;
+			MakeMask((u32)hash, lo, hi);
+			__m256i* words = reinterpret_cast<__m256i*>(block.Words);
+			_mm256_store_si256(words, _mm256_or_si256(_mm256_load_si256(words), lo));
+			_mm256_store_si256(words + 1, _mm256_or_si256(_mm256_load_si256(words + 1), hi));
+#else
+			for (u32 i = 0; i < kWordsPerBlock; ++i)
+				block.Words[i] |= BitOf((u32)hash, i);
+#endif
+		}
+
+		bool MayContainHash(u64 hash) const
+		{
+			assert(!Blocks.empty()); // a moved from filter
+			const Block& block = Blocks[sketch_impl::FastRange((u32)(hash >> 32), (u32)Blocks.size())];
+#if VEX_BLOOM_AVX2
+			__m256i lo, hi;
+			MakeMask((u32)hash, lo, hi);
+			const __m256i* words = reinterpret_cast<const __m256i*>(block.Words);
+			return _mm256_testc_si256(_mm256_load_si256(words), lo) &
+				   _mm256_testc_si256(_mm256_load_si256(words + 1), hi);
+#else
+			u64 missing = 0;
+			for (u32 i = 0; i < kWordsPerBlock; ++i)
+				missing |= BitOf((u32)hash, i) & ~block.Words[i];
+			return missing == 0;
+#endif
+		}
+
+		// union of both key sets, sizes must match
+		void Merge(const BlockedBloomFilter& other)
+		{
+			assert(Blocks.size() == other.Blocks.size());
+			for (size_t b = 0; b < Blocks.size(); ++b)
+			{
+				for (u32 i = 0; i < kWordsPerBlock; ++i)
+					Blocks[b].Words[i] |= other.Blocks[b].Words[i];
+			}
+		}
+
+		void Clear()
+		{
+			for (Block& block : Blocks)
+				block = Block{};
+		}
+
+		u32 BlockCount() const noexcept { return (u32)Blocks.size(); }
+		size_t SizeInBytes() const noexcept { return Blocks.size() * sizeof(Block); }
+
+		// expected false positive rate with keyCount keys spread over blockCount blocks:
+		// block loads are Poisson, a block holding c keys has each word bit set with p = 1 - (63/64)^c
+		static double FalsePositiveRate(size_t keyCount, u32 blockCount)
+		{
+			const double lambda = (double)keyCount / blockCount;
+			if (lambda <= 0.0)
+				return 0.0;
+			// only loads within ~10 deviations of the mean matter, log space keeps exp(-lambda) from underflowing
+			const double spread = 10.0 * std::sqrt(lambda) + 20.0;
+			const int minLoad = lambda > spread ? (int)(lambda - spread) : 0;
+			const int maxLoad = (int)(lambda + spread);
+			const double logLambda = std::log(lambda);
+			double rate = 0.0;
+			for (int c = minLoad; c <= maxLoad; ++c)
+			{
+				const double poisson = std::exp(c * logLambda - lambda - std::lgamma(c + 1.0));
+				rate += poisson * std::pow(1.0 - std::pow(63.0 / 64.0, c), (double)kWordsPerBlock);
+			}
+			return rate;
+		}
+
+		static u32 BlocksFor(size_t expectedKeys, double falsePositiveRate)
+		{
+			u32 high = 1;
+			while (high < (1u << 31) && FalsePositiveRate(expectedKeys, high) > falsePositiveRate)
+				high *= 2;
+			u32 low = high / 2;
+			while (low + 1 < high)
+			{
+				const u32 mid = low + (high - low) / 2;
+				if (FalsePositiveRate(expectedKeys, mid) > falsePositiveRate)
+					low = mid;
+				else
+					high = mid;
+			}
+			return high;
+		}
+
+	private:
+		// parquet split block salts, odd so each multiply is a bijection
+		static constexpr u32 kSalt[kWordsPerBlock] = {
+			0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+
+		static u64 BitOf(u32 hash, u32 word) { return 1ull << ((hash * kSalt[word]) >> 26); }
+
+#if VEX_BLOOM_AVX2
+		// 8 multiplies and shifts at once, the 6 bit indices widened to 64 bit lanes for the variable shift
+		static void MakeMask(u32 hash, __m256i& lo, __m256i& hi)
+		{
+			const __m256i salt = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kSalt));
+			const __m256i index = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)hash), salt), 26);
+			const __m256i one = _mm256_set1_epi64x(1);
+			lo = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(index)));
+			hi = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(index, 1)));
+		}
+#endif
+
+		std::vector<Block> Blocks;
+	};
+
+	// Count-Min sketch: Depth rows of Width counters, an estimate is the minimum over the rows.
+	// never underestimates; with Width = e / epsilon and Depth = ln(1 / delta) the overestimate is
+	// below epsilon * TotalCount() with probability 1 - delta. row indices come from one 64 bit hash
+	// (h1 + i * h2). sketches of the same shape built on different threads combine with Merge.
+	template <typename THashPolicy = util::SHash_MURMUR>
+	struct CountMinSketch
+	{
+		CountMinSketch() : CountMinSketch(1, 1) {}
+		CountMinSketch(u32 width, u32 depth)
+			: Width(width ? width : 1), Depth(depth ? depth : 1), Counters((size_t)Width * Depth)
+		{
+		}
+
+		static CountMinSketch FromErrorRate(double epsilon, double delta)
+		{
+			return CountMinSketch((u32)std::ceil(2.718281828459045 / epsilon), (u32)std::ceil(std::log(1.0 / delta)));
+		}
+
+		template <typename T>
+		void Add(const T& key, u32 count = 1)
+		{
+			AddHash(sketch_impl::Hash64<THashPolicy>(key), count);
+		}
+		template <typename T>
+		u32 Estimate(const T& key) const
+		{
+			return EstimateHash(sketch_impl::Hash64<THashPolicy>(key));
+		}
+
+		void AddHash(u64 hash, u32 count = 1)
+		{
+			u32* row = Counters.data();
+			for (u32 i = 0; i < Depth; ++i, row += Width)
+				row[Column(hash, i)] += count;
+			Total += count;
+		}
+
+		u32 EstimateHash(u64 hash) const
+		{
+			const u32* row = Counters.data();
+			u32 estimate = 0xffffffffu;
+			for (u32 i = 0; i < Depth; ++i, row += Width)
+			{
+				const u32 value = row[Column(hash, i)];
+				estimate = value < estimate ? value : estimate;
+			}
+			return estimate;
+		}
+
+		// counts of both streams, shapes must match
+		void Merge(const CountMinSketch& other)
+		{
+			assert(Width == other.Width && Depth == other.Depth);
+			for (size_t i = 0; i < Counters.size(); ++i)
+				Counters[i] += other.Counters[i];
+			Total += other.Total;
+		}
+
+		void Clear()
+		{
+			for (u32& counter : Counters)
+				counter = 0;
+			Total = 0;
+		}
+
+		u32 GetWidth() const noexcept { return Width; }
+		u32 GetDepth() const noexcept { return Depth; }
+		u64 TotalCount() const noexcept { return Total; }
+
+	private:
+		u32 Column(u64 hash, u32 row) const
+		{
+			const u32 h1 = (u32)hash;
+			const u32 h2 = (u32)(hash >> 32) | 1;
+			return sketch_impl::FastRange(h1 + row * h2, Width);
+		}
+
+		u32 Width = 0;
+		u32 Depth = 0;
+		std::vector<u32> Counters;
+		u64 Total = 0;
+	};
+} // namespace vex
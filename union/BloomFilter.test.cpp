@@ -0,0 +1,142 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for BloomFilter.h, from the repository root:
+//	g++ -std=c++20 -I. union/BloomFilter.test.cpp -o bloom_test && ./bloom_test
+// build once more with -mavx2 to cover the AVX2 bit masks as well as the scalar ones
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "BloomFilter.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+namespace
+{
+	template <typename THashPolicy>
+	void CheckBloom(const char* name)
+	{
+		constexpr size_t kKeys = 100000;
+		constexpr double kTarget = 0.01;
+		vex::BlockedBloomFilter<THashPolicy> filter(kKeys, kTarget);
+		VEX_CHECK(vex::BlockedBloomFilter<THashPolicy>::FalsePositiveRate(kKeys, filter.BlockCount()) <= kTarget);
+
+		// odd keys inserted, even keys only queried
+		for (u64 i = 0; i < kKeys; ++i)
+			filter.Insert(i * 2 + 1);
+		u32 found = 0;
+		for (u64 i = 0; i < kKeys; ++i)
+			found += filter.MayContain(i * 2 + 1);
+		VEX_CHECK(found == kKeys);
+
+		u32 falsePositives = 0;
+		for (u64 i = 0; i < 10 * kKeys; ++i)
+			falsePositives += filter.MayContain(i * 2);
+		const double rate = (double)falsePositives / (10 * kKeys);
+		std::printf("%-8s false positive rate %.4f (target %.4f, %u blocks)\n", name, rate, kTarget, filter.BlockCount());
+		VEX_CHECK(rate < 1.5 * kTarget);
+
+		// strings go through the string_view hash, not their bytes
+		vex::BlockedBloomFilter<THashPolicy> strings(1000, 0.01);
+		strings.Insert(std::string("alpha"));
+		VEX_CHECK(strings.MayContain("alpha") && strings.MayContain(std::string_view("alpha")));
+	}
+
+	// default constructed sketches are usable, just small
+	void CheckDefaults()
+	{
+		vex::BlockedBloomFilter<> filter;
+		VEX_CHECK(filter.BlockCount() == 1 && !filter.MayContain(7));
+		for (int i = 0; i < 10; ++i)
+			filter.Insert(i);
+		u32 found = 0;
+		for (int i = 0; i < 10; ++i)
+			found += filter.MayContain(i);
+		VEX_CHECK(found == 10);
+
+		vex::CountMinSketch<> sketch;
+		VEX_CHECK(sketch.Estimate(3) == 0);
+		sketch.Add(3, 2);
+		sketch.Add(4);
+		VEX_CHECK(sketch.Estimate(3) == 3 && sketch.TotalCount() == 3);
+	}
+
+	void CheckMergeAndClear()
+	{
+		vex::BlockedBloomFilter<> left(64u), right(64u);
+		for (int i = 0; i < 500; ++i)
+			(i % 2 ? left : right).Insert(i);
+		left.Merge(right);
+		u32 found = 0;
+		for (int i = 0; i < 500; ++i)
+			found += left.MayContain(i);
+		VEX_CHECK(found == 500);
+		VEX_CHECK(left.SizeInBytes() == 64 * 64);
+
+		left.Clear();
+		found = 0;
+		for (int i = 0; i < 500; ++i)
+			found += left.MayContain(i);
+		VEX_CHECK(found == 0);
+	}
+
+	// skewed stream, a few heavy keys and a long tail
+	void CheckCountMin()
+	{
+		constexpr double kEpsilon = 0.001;
+		constexpr double kDelta = 0.01;
+		auto sketch = vex::CountMinSketch<>::FromErrorRate(kEpsilon, kDelta);
+		VEX_CHECK(sketch.GetWidth() == 2719 && sketch.GetDepth() == 5);
+
+		std::unordered_map<u32, u32> exact;
+		std::mt19937 rng(5);
+		std::geometric_distribution<u32> skew(0.001);
+		vex::CountMinSketch<> half(sketch.GetWidth(), sketch.GetDepth());
+		for (int i = 0; i < 200000; ++i)
+		{
+			const u32 key = skew(rng);
+			const u32 count = 1 + rng() % 3;
+			exact[key] += count;
+			(i % 2 ? sketch : half).Add(key, count);
+		}
+		sketch.Merge(half);
+
+		u64 total = 0;
+		for (const auto& [key, count] : exact)
+			total += count;
+		VEX_CHECK(sketch.TotalCount() == total);
+
+		u32 under = 0, withinBound = 0;
+		for (const auto& [key, count] : exact)
+		{
+			const u32 estimate = sketch.Estimate(key);
+			under += estimate < count;
+			withinBound += estimate - count <= kEpsilon * total;
+		}
+		VEX_CHECK(under == 0);
+		VEX_CHECK(withinBound >= (1.0 - kDelta) * exact.size());
+
+		sketch.Clear();
+		VEX_CHECK(sketch.Estimate(0u) == 0 && sketch.TotalCount() == 0);
+	}
+} // namespace
+
+int main()
+{
+	CheckBloom<vex::util::SHash_MURMUR>("murmur3");
+	CheckBloom<vex::util::SHash_WY>("wyhash");
+	CheckDefaults();
+	CheckMergeAndClear();
+	CheckCountMin();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -3,9 +3,12 @@
  * MIT LICENSE
  * Copyright (c) 2019 Vladyslav Joss
  */
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 
+#include "Meta.h"
+
 using u64 = uint64_t;
 using u32 = uint32_t;
 using u16 = uint16_t;
@@ -13,6 +16,7 @@ using u16 = uint16_t;
 using i64 = int64_t;
 using i32 = int32_t;
 using i16 = int16_t;
+using i8 = int8_t;
 
 using u8 = unsigned char;
 using byte = unsigned char;
@@ -22,72 +26,36 @@ namespace vex::memory
 	template <typename... Types>
 	constexpr auto MaxSizeOf()
 	{
-		constexpr size_t list[sizeof...(Types)] = {sizeof(Types)...};
-		auto It = &list[0];
-		auto End = &list[sizeof...(Types)];
-		auto Curmax = *It;
-		for (; It != End; ++It)
-		{
-			Curmax = (Curmax > *It) ? Curmax : *It;
-		}
-		return Curmax;
+		return meta::MaxSizeOf<Types...>;
 	};
 
 	template <typename... Types>
 	constexpr auto MaxAlignOf()
 	{
-		constexpr size_t list[sizeof...(Types)] = {alignof(Types)...};
-		auto It = &list[0];
-		auto End = &list[sizeof...(Types)];
-		auto Curmax = *It;
-		for (; It != End; ++It)
-		{
-			Curmax = (Curmax > *It) ? Curmax : *It;
-		}
-		return Curmax;
+		return meta::MaxAlignOf<Types...>;
 	};
 } // namespace vex::memory
 
 
 namespace vex::traits
 {
-	static constexpr size_t kTypeIndexNone = 0xff;
-	template <typename TType>
+	static constexpr size_t kTypeIndexNone = meta::kIndexNone;
+	template <typename TType, typename... TRest>
 	constexpr size_t GetTypeIndexInList() // #todo => rename
 	{
-		return kTypeIndexNone;
-	}
-	template <typename TType, typename TFirstType, typename... TRest>
-	constexpr size_t GetTypeIndexInList()
-	{
-		if constexpr (!std::is_same<TType, TFirstType>::value)
-			return 1 + GetTypeIndexInList<TType, TRest...>();
-		return 0;
+		return meta::IndexOf<TType, TRest...>;
 	}
 
 	template <typename TType, typename... TRest>
 	constexpr size_t GetIndex()
 	{
-		constexpr auto val = GetTypeIndexInList<TType, TRest...>();
-		return val > kTypeIndexNone ? kTypeIndexNone : val;
+		return meta::IndexOf<TType, TRest...>;
 	}
 
-	template <typename TType>
-	constexpr bool HasType()
-	{
-		return false;
-	}
-	template <>
-	constexpr bool HasType<void>()
-	{
-		return false;
-	}
-	template <typename TType, typename TFirstType, typename... TRest>
+	template <typename TType, typename... TRest>
 	constexpr bool HasType()
 	{
-		if constexpr (!std::is_same<TType, TFirstType>::value)
-			return HasType<TType, TRest...>();
-		return true;
+		return meta::Contains<TType, TRest...>;
 	}
 	template <typename... TRest>
 	constexpr bool AreAllTrivial()
@@ -95,6 +63,20 @@ namespace vex::traits
 		return (... && std::is_trivial_v<TRest>);
 	}
 
+	// safe to move to a new address with memcpy and no destructor call on the old copy
+	template <typename... TRest>
+	constexpr bool AreAllTriviallyRelocatable()
+	{
+		return (... && std::is_trivially_copyable_v<TRest>);
+	}
+
+	// values that are equal exactly when their bytes are, whatever operator== they might declare:
+	// integers, enums and pointers. char pointers are strings to the hashers, so they are left out
+	template <typename T>
+	constexpr bool IsByteValue =
+		std::is_integral_v<T> || std::is_enum_v<T> ||
+		(std::is_pointer_v<T> && !std::is_same_v<std::remove_cv_t<std::remove_pointer_t<T>>, char>);
+
 	template <typename T, typename... TRest>
 	constexpr bool IsConvertible()
 	{
@@ -126,35 +108,88 @@ namespace vex::traits
 	{
 	};
 
-	template <typename T>
-	struct FunctorTraits : public FunctorTraits<decltype(&T::operator())>
-	{
-	};
-
-	template <typename ClassType, typename ReturnType, typename... Args>
-	struct FunctorTraits<ReturnType (ClassType::*)(Args...) const>
+	namespace private_impl
 	{
-		typedef ReturnType TResult;
+		// what every FunctorTraits specialization reports, Args exclude the object of member functions
+		template <bool Noexcept, typename ReturnType, typename... Args>
+		struct CallableTraits
+		{
+			typedef ReturnType TResult;
+			typedef ReturnType TSignature(Args...);
 
-		static constexpr size_t Arity = sizeof...(Args);
+			static constexpr size_t Arity = sizeof...(Args);
+			static constexpr bool IsNoexcept = Noexcept;
 
-		template <std::size_t I, typename T>
-		struct ArgTypes;
+			template <std::size_t I>
+			using ArgT = meta::At<I, Args...>;
 
-		template <std::size_t I, typename Head, typename... Tail>
-		struct ArgTypes<I, TTypeList<Head, Tail...>> : ArgTypes<I - 1, TTypeList<Tail...>>
-		{
-			typedef Head type;
+			template <std::size_t I>
+			using ArgTypesT = typename std::decay_t<ArgT<I>>;
 		};
 
-		template <typename Head, typename... Tail>
-		struct ArgTypes<0, TTypeList<Head, Tail...>>
+		template <typename ClassType, bool Const, bool Noexcept, typename ReturnType, typename... Args>
+		struct MemberCallableTraits : CallableTraits<Noexcept, ReturnType, Args...>
 		{
-			typedef Head type;
+			typedef ClassType TClass;
+			static constexpr bool IsConst = Const;
 		};
+	} // namespace private_impl
 
-		template <std::size_t I>
-		using ArgTypesT = typename std::decay_t<typename ArgTypes<I, TTypeList<Args...>>::type>;
+	// lambdas and functors (through operator(), mutable ones included), plain functions, function
+	// pointers and member function pointers. cv and reference qualifiers on the callable are ignored
+	template <typename T>
+	struct FunctorTraits : public FunctorTraits<decltype(&T::operator())>
+	{
+	};
+	template <typename T>
+	struct FunctorTraits<const T> : public FunctorTraits<T>
+	{
+	};
+	template <typename T>
+	struct FunctorTraits<T&> : public FunctorTraits<T>
+	{
+	};
+	template <typename T>
+	struct FunctorTraits<T&&> : public FunctorTraits<T>
+	{
+	};
+
+	template <typename ReturnType, typename... Args>
+	struct FunctorTraits<ReturnType(Args...)> : private_impl::CallableTraits<false, ReturnType, Args...>
+	{
+	};
+	template <typename ReturnType, typename... Args>
+	struct FunctorTraits<ReturnType(Args...) noexcept> : private_impl::CallableTraits<true, ReturnType, Args...>
+	{
+	};
+	template <typename ReturnType, typename... Args>
+	struct FunctorTraits<ReturnType (*)(Args...)> : public FunctorTraits<ReturnType(Args...)>
+	{
+	};
+	template <typename ReturnType, typename... Args>
+	struct FunctorTraits<ReturnType (*)(Args...) noexcept> : public FunctorTraits<ReturnType(Args...) noexcept>
+	{
+	};
+
+	template <typename ClassType, typename ReturnType, typename... Args>
+	struct FunctorTraits<ReturnType (ClassType::*)(Args...)>
+		: private_impl::MemberCallableTraits<ClassType, false, false, ReturnType, Args...>
+	{
+	};
+	template <typename ClassType, typename ReturnType, typename... Args>
+	struct FunctorTraits<ReturnType (ClassType::*)(Args...) const>
+		: private_impl::MemberCallableTraits<ClassType, true, false, ReturnType, Args...>
+	{
+	};
+	template <typename ClassType, typename ReturnType, typename... Args>
+	struct FunctorTraits<ReturnType (ClassType::*)(Args...) noexcept>
+		: private_impl::MemberCallableTraits<ClassType, false, true, ReturnType, Args...>
+	{
+	};
+	template <typename ClassType, typename ReturnType, typename... Args>
+	struct FunctorTraits<ReturnType (ClassType::*)(Args...) const noexcept>
+		: private_impl::MemberCallableTraits<ClassType, true, true, ReturnType, Args...>
+	{
 	};
 } // namespace vex::traits
 
@@ -166,6 +201,13 @@ namespace vex
 		{
 		};
 	} // namespace impl
+
+	template <size_t index, typename... Args>
+	struct GetTypeByIndex
+	{
+		using type = meta::At<index, Args...>;
+	};
+
 	template <int Start, int End>
 	struct CRange
 	{
@@ -192,13 +234,33 @@ namespace vex
 			int32_t Current = _s;
 		};
 
-		SqIterator begin() noexcept { return SqIterator{}; };
+		SqIterator begin() const noexcept { return SqIterator{}; };
 		impl::__vexSentinel end() const noexcept { return kSqEnd; };
 	};
 
 	template <int End>
 	using ZeroTo = CRange<0, End>;
 
+	// what Range::begin() returns: two ints and no copy of the Range, so the loop variable is a plain
+	// induction variable the optimizer can vectorize like a raw for loop
+	struct RangeIterator
+	{
+		friend bool operator==(RangeIterator lhs, impl::__vexSentinel) { return lhs.Current >= lhs.End; }
+		friend bool operator==(impl::__vexSentinel lhs, RangeIterator rhs) { return rhs == lhs; }
+		friend bool operator!=(RangeIterator lhs, impl::__vexSentinel rhs) { return !(lhs == rhs); }
+		friend bool operator!=(impl::__vexSentinel lhs, RangeIterator rhs) { return !(lhs == rhs); }
+
+		inline int operator*() const { return Current; }
+		inline RangeIterator& operator++()
+		{
+			++Current;
+			return *this;
+		}
+
+		int Current;
+		int End;
+	};
+
 	struct Range
 	{
 		static constexpr const impl::__vexSentinel kSqEnd = impl::__vexSentinel{};
@@ -226,9 +288,10 @@ namespace vex
 		int End = 0;
 		int Current = 0;
 
-		Range begin() noexcept { return Range{0, Start, End}; };
+		RangeIterator begin() const noexcept { return RangeIterator{Start, End}; };
+		int Size() const noexcept { return End > Start ? End - Start : 0; }
 		impl::__vexSentinel end() const noexcept { return kSqEnd; };
 	};
 
-	Range operator"" _times(unsigned long long x) { return Range((int)x); }
+	inline Range operator"" _times(unsigned long long x) { return Range((int)x); }
 } // namespace vex
@@ -0,0 +1,240 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <atomic>
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define VEX_FASTHASH_X64 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define VEX_FASTHASH_TARGET(isa)
+#else
+#include <cpuid.h>
+#define VEX_FASTHASH_TARGET(isa) __attribute__((target(isa)))
+#endif
+#include <immintrin.h>
+#else
+#define VEX_FASTHASH_X64 0
+#endif
+
+#include "CoreTemplates.h"
+#include "HashUtils.h"
+
+namespace vex::util
+{
+	// SHash_Fast picks its implementation once, at first use, from what the cpu supports.
+	// values differ between backends: never persist them or send them to another machine
+	enum class FastHashBackend : u8
+	{
+		Scalar, // wyhash, any cpu
+		Crc32c, // SSE4.2 crc32 instruction, 3 lanes of 8 bytes
+		Aes,	// AES-NI rounds, 32 bytes per iteration
+	};
+
+	namespace fast_hash_impl
+	{
+		using HashFunc = u64 (*)(const void*, std::size_t, u64);
+
+		inline u64 HashScalar(const void* data, std::size_t size, u64 seed)
+		{
+			return wyhash(std::string_view((const char*)data, size), seed);
+		}
+
+#if VEX_FASTHASH_X64
+		// crc32c is linear, so the lanes are only a fast compressor, the final multiply does the mixing
+		VEX_FASTHASH_TARGET("sse4.2")
+		inline u64 HashCrc32c(const void* data, std::size_t size, u64 seed)
+		{
+			using namespace wyhash_impl;
+			const char* p = (const char*)data;
+			u64 a = (u32)seed;
+			u64 b = seed >> 32;
+			u64 c = kP2;
+			if (size <= 16)
+			{
+				u64 x, y;
+				ReadShort(p, size, x, y);
+				a = _mm_crc32_u64(a, x);
+				b = _mm_crc32_u64(b, y);
+			}
+			else
+			{
+				const char* end = p + size;
+				while (end - p > 24)
+				{
+					a = _mm_crc32_u64(a, Read8(p));
+					b = _mm_crc32_u64(b, Read8(p + 8));
+					c = _mm_crc32_u64(c, Read8(p + 16));
+					p += 24;
+				}
+				// 1..24 bytes left, covered by reads that may overlap already hashed input
+				if (end - p > 16)
+					a = _mm_crc32_u64(a, Read8(p));
+				b = _mm_crc32_u64(b, Read8(end - 16));
+				c = _mm_crc32_u64(c, Read8(end - 8));
+			}
+			// lanes go to different multiply operands, short keys feed the same words to a and b
+			a = Mix(a ^ (c << 32) ^ kP0, b ^ ((u64)size << 32) ^ kP1);
+			return Mix(a ^ seed ^ kP2, a ^ kP3);
+		}
+
+		// data blocks are used as round keys, the tail is read as the last 16/32 bytes of input
+		VEX_FASTHASH_TARGET("aes,sse4.1")
+		inline u64 HashAes(const void* data, std::size_t size, u64 seed)
+		{
+			using namespace wyhash_impl;
+			const char* p = (const char*)data;
+			const __m128i key0 = _mm_set_epi64x((long long)kP1, (long long)(kP0 ^ seed));
+			const __m128i key1 = _mm_set_epi64x((long long)(kP3 ^ (u64)size), (long long)kP2);
+			__m128i a = key0;
+			__m128i b = key1;
+			if (size <= 16)
+			{
+				u64 x, y;
+				ReadShort(p, size, x, y);
+				a = _mm_xor_si128(a, _mm_set_epi64x((long long)y, (long long)x));
+			}
+			else
+			{
+				const char* end = p + size;
+				while (end - p > 32)
+				{
+					a = _mm_aesenc_si128(a, _mm_loadu_si128((const __m128i*)p));
+					b = _mm_aesenc_si128(b, _mm_loadu_si128((const __m128i*)(p + 16)));
+					p += 32;
+				}
+				if (end - p > 16)
+					a = _mm_aesenc_si128(a, _mm_loadu_si128((const __m128i*)p));
+				b = _mm_aesenc_si128(b, _mm_loadu_si128((const __m128i*)(end - 16)));
+			}
+			// two rounds per lane before they meet, one round lets equal single byte differences cancel
+			a = _mm_aesenc_si128(a, key1);
+			b = _mm_aesenc_si128(b, key0);
+			a = _mm_aesenc_si128(a, b);
+			a = _mm_aesenc_si128(a, key1);
+			a = _mm_aesenc_si128(a, key0);
+			return (u64)_mm_cvtsi128_si64(a) ^ (u64)_mm_extract_epi64(a, 1);
+		}
+
+		inline bool CpuHas(int ecxBit)
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[2] >> ecxBit) & 1;
+#else
+			unsigned eax, ebx, ecx, edx;
+			if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+				return false;
+			return (ecx >> ecxBit) & 1;
+#endif
+		}
+		static constexpr int kCpuidSse41 = 19;
+		static constexpr int kCpuidSse42 = 20;
+		static constexpr int kCpuidAes = 25;
+#endif
+
+		inline HashFunc FuncOf(FastHashBackend backend)
+		{
+			switch (backend)
+			{
+#if VEX_FASTHASH_X64
+			case FastHashBackend::Crc32c:
+				return &HashCrc32c;
+			case FastHashBackend::Aes:
+				return &HashAes;
+#endif
+			default:
+				return &HashScalar;
+			}
+		}
+	} // namespace fast_hash_impl
+
+	inline bool IsFastHashBackendSupported(FastHashBackend backend)
+	{
+		switch (backend)
+		{
+		case FastHashBackend::Scalar:
+			return true;
+#if VEX_FASTHASH_X64
+		case FastHashBackend::Crc32c:
+			return fast_hash_impl::CpuHas(fast_hash_impl::kCpuidSse42);
+		case FastHashBackend::Aes:
+			return fast_hash_impl::CpuHas(fast_hash_impl::kCpuidAes) &&
+				   fast_hash_impl::CpuHas(fast_hash_impl::kCpuidSse41);
+#endif
+		default:
+			return false;
+		}
+	}
+
+	// aes first: it measured at least as fast as crc32c at every key length, and mixes better
+	inline FastHashBackend BestFastHashBackend()
+	{
+		if (IsFastHashBackendSupported(FastHashBackend::Aes))
+			return FastHashBackend::Aes;
+		if (IsFastHashBackendSupported(FastHashBackend::Crc32c))
+			return FastHashBackend::Crc32c;
+		return FastHashBackend::Scalar;
+	}
+
+	namespace fast_hash_impl
+	{
+		struct Dispatch
+		{
+			std::atomic<HashFunc> Func;
+			std::atomic<FastHashBackend> Backend;
+
+			Dispatch() : Func(FuncOf(BestFastHashBackend())), Backend(BestFastHashBackend()) {}
+
+			// function local so SHash_Fast is usable from other static initializers
+			static Dispatch& Get()
+			{
+				static Dispatch instance;
+				return instance;
+			}
+		};
+	} // namespace fast_hash_impl
+
+	inline FastHashBackend ActiveFastHashBackend()
+	{
+		return fast_hash_impl::Dispatch::Get().Backend.load(std::memory_order_relaxed);
+	}
+
+	// forces a backend, for tests and benchmarks. every table hashed with SHash_Fast
+	// before the switch is invalid afterwards. returns false if the cpu lacks it
+	inline bool SetFastHashBackend(FastHashBackend backend)
+	{
+		if (!IsFastHashBackendSupported(backend))
+			return false;
+		auto& dispatch = fast_hash_impl::Dispatch::Get();
+		dispatch.Func.store(fast_hash_impl::FuncOf(backend), std::memory_order_relaxed);
+		dispatch.Backend.store(backend, std::memory_order_relaxed);
+		return true;
+	}
+
+	// one backend explicitly, bypassing dispatch. the backend must be supported
+	inline u64 FastHash64(FastHashBackend backend, const void* data, std::size_t size, u64 seed = 0)
+	{
+		return fast_hash_impl::FuncOf(backend)(data, size, seed);
+	}
+
+	inline u64 FastHash64(const void* data, std::size_t size, u64 seed = 0)
+	{
+		return fast_hash_impl::Dispatch::Get().Func.load(std::memory_order_relaxed)(data, size, seed);
+	}
+	inline u64 FastHash64(std::string_view key, u64 seed = 0) { return FastHash64(key.data(), key.size(), seed); }
+
+	struct SHash_Fast
+	{
+		static inline int Hash(ByteSpan bytes) { return HashBytes(bytes.data(), bytes.size()); }
+		static inline int Hash(std::string_view str) { return HashBytes(str.data(), str.size()); }
+		static inline int HashBytes(const void* data, std::size_t size) { return (int)FastHash64(data, size); }
+		static inline uint64_t Hash64(std::string_view str) { return FastHash64(str); }
+		static inline uint64_t Hash64(const void* data, std::size_t size) { return FastHash64(data, size); }
+	};
+} // namespace vex::util
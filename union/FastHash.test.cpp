@@ -0,0 +1,111 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for FastHash.h, every backend the cpu supports, from the repository root:
+//	g++ -std=c++20 -fsanitize=address -I. union/FastHash.test.cpp -o fasthash_test && ./fasthash_test
+// under -fsanitize=address every key sits in its own exact size allocation, so a read past the end is reported
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "FastHash.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using namespace vex::util;
+
+namespace
+{
+	constexpr FastHashBackend kBackends[] = {FastHashBackend::Scalar, FastHashBackend::Crc32c, FastHashBackend::Aes};
+
+	std::unique_ptr<char[]> MakeKey(size_t length)
+	{
+		std::unique_ptr<char[]> key(new char[length ? length : 1]);
+		for (size_t i = 0; i < length; ++i)
+			key[i] = (char)(i * 131 + 7);
+		return key;
+	}
+
+	// lengths 0..300 cover every short/tail/loop split of all backends
+	void CheckBackend(FastHashBackend backend)
+	{
+		std::set<u64> seen;
+		u32 stable = 0, seeded = 0, flips = 0, flipTotal = 0;
+		for (size_t length = 0; length <= 300; ++length)
+		{
+			std::unique_ptr<char[]> key = MakeKey(length);
+			const u64 hash = FastHash64(backend, key.get(), length);
+			stable += hash == FastHash64(backend, key.get(), length);
+			seeded += hash != FastHash64(backend, key.get(), length, 1);
+			seen.insert(hash);
+
+			// every input bit of the first and last 8 bytes reaches the result
+			for (size_t byte = 0; byte < length; byte = byte + 1 == 8 && length > 16 ? length - 8 : byte + 1)
+			{
+				for (int bit = 0; bit < 8; ++bit)
+				{
+					key[byte] ^= (char)(1 << bit);
+					flips += FastHash64(backend, key.get(), length) != hash;
+					key[byte] ^= (char)(1 << bit);
+					++flipTotal;
+				}
+			}
+		}
+		VEX_CHECK(stable == 301);
+		VEX_CHECK(seeded == 301);
+		VEX_CHECK(seen.size() == 301);
+		VEX_CHECK(flips == flipTotal);
+
+		// keys of equal content at different addresses
+		const std::string text = "unaligned keys hash by content, not by address";
+		std::unique_ptr<char[]> shifted(new char[text.size() + 3]);
+		text.copy(shifted.get() + 3, text.size());
+		VEX_CHECK(FastHash64(backend, text.data(), text.size()) == FastHash64(backend, shifted.get() + 3, text.size()));
+	}
+
+	void CheckDispatch()
+	{
+		const FastHashBackend initial = ActiveFastHashBackend();
+		VEX_CHECK(initial == BestFastHashBackend());
+		VEX_CHECK(IsFastHashBackendSupported(FastHashBackend::Scalar));
+
+		const std::string_view key = "dispatched through SHash_Fast";
+		for (FastHashBackend backend : kBackends)
+		{
+			if (!SetFastHashBackend(backend))
+				continue;
+			VEX_CHECK(ActiveFastHashBackend() == backend);
+			const u64 expected = FastHash64(backend, key.data(), key.size());
+			VEX_CHECK(FastHash64(key) == expected);
+			VEX_CHECK(SHash_Fast::Hash64(key) == expected);
+			VEX_CHECK(SHash_Fast::Hash(key) == (int)expected);
+			VEX_CHECK(SHash_Fast::HashBytes(key.data(), key.size()) == (int)expected);
+		}
+		SetFastHashBackend(initial);
+	}
+} // namespace
+
+int main()
+{
+	for (FastHashBackend backend : kBackends)
+	{
+		if (!IsFastHashBackendSupported(backend))
+		{
+			std::printf("backend %d not supported, skipped\n", (int)backend);
+			continue;
+		}
+		CheckBackend(backend);
+	}
+	// the portable backend is plain wyhash
+	VEX_CHECK(FastHash64(FastHashBackend::Scalar, "abc", 3, 2) == wyhash("abc", 2));
+	CheckDispatch();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -0,0 +1,278 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "CoreTemplates.h"
+
+// std::function replacements that never touch the heap:
+//	FunctionRef<Sig>			refers to a callable owned by someone else. for parameters
+//	InplaceFunction<Sig, N>		owns a copyable callable of up to N bytes stored inside the object. for members
+//	InplaceMoveFunction<Sig, N>	the same for move only callables, cannot be copied itself. for queues
+// both deduce Sig from a lambda or a function through traits::FunctorTraits:
+//	void ForEachHit(FunctionRef<void(const Hit&)> onHit);
+//	InplaceFunction callback = [this](int code) { OnDone(code); };
+namespace vex
+{
+	namespace function_impl
+	{
+		template <typename T>
+		constexpr bool IsFunctionPointer = std::is_pointer_v<T> && std::is_function_v<std::remove_pointer_t<T>>;
+
+		// never defined, a pointer to a member function of an unknown class is the largest member pointer
+		struct AnyClass;
+		using AnyMethod = void (AnyClass::*)();
+
+		template <typename T, typename TSelf>
+		constexpr bool IsSelf = std::is_same_v<std::remove_cvref_t<T>, TSelf>;
+
+		// std::invoke that converts to ReturnType, or drops the result when ReturnType is void
+		template <typename ReturnType, typename TFunc, typename... Args>
+		inline ReturnType InvokeR(TFunc&& func, Args&&... args)
+		{
+			if constexpr (std::is_void_v<ReturnType>)
+				std::invoke(std::forward<TFunc>(func), std::forward<Args>(args)...);
+			else
+				return std::invoke(std::forward<TFunc>(func), std::forward<Args>(args)...);
+		}
+	} // namespace function_impl
+
+	template <typename TSignature>
+	struct FunctionRef;
+
+	// non-owning: the callable must outlive the FunctionRef, so keep it to parameters and locals.
+	// functions, function pointers and member pointers are stored by value, everything else by address
+	template <typename ReturnType, typename... Args>
+	struct FunctionRef<ReturnType(Args...)>
+	{
+		template <typename TFunc>
+			requires(!function_impl::IsSelf<TFunc, FunctionRef> && std::is_invocable_r_v<ReturnType, TFunc&, Args...>)
+		FunctionRef(TFunc&& func) noexcept
+		{
+			using TCallable = std::remove_reference_t<TFunc>;
+			if constexpr (std::is_function_v<TCallable> || function_impl::IsFunctionPointer<std::decay_t<TCallable>>)
+			{
+				using TPointer = std::decay_t<TCallable>;
+				Callable.Function = reinterpret_cast<void (*)()>(static_cast<TPointer>(func));
+				Invoker = &InvokeFunction<TPointer>;
+			}
+			else if constexpr (std::is_member_pointer_v<std::remove_cv_t<TCallable>>)
+			{
+				// &Type::Method is usually a temporary, its address would dangle
+				using TMember = std::remove_cv_t<TCallable>;
+				static_assert(sizeof(TMember) <= sizeof(Callable.Member), "member pointer does not fit FunctionRef");
+				std::memcpy(Callable.Member, &func, sizeof(TMember));
+				Invoker = &InvokeMember<TMember>;
+			}
+			else
+			{
+				Callable.Object = (void*)std::addressof(func);
+				Invoker = &InvokeObject<TCallable>;
+			}
+		}
+
+		FunctionRef(const FunctionRef&) = default;
+		FunctionRef& operator=(const FunctionRef&) = default;
+
+		ReturnType operator()(Args... args) const { return Invoker(Callable, std::forward<Args>(args)...); }
+
+	private:
+		union Storage
+		{
+			void* Object;
+			void (*Function)();
+			alignas(function_impl::AnyMethod) byte Member[sizeof(function_impl::AnyMethod)];
+		};
+
+		template <typename TCallable>
+		static ReturnType InvokeObject(const Storage& callable, Args&&... args)
+		{
+			return function_impl::InvokeR<ReturnType>(
+				*static_cast<TCallable*>(callable.Object), std::forward<Args>(args)...);
+		}
+
+		template <typename TPointer>
+		static ReturnType InvokeFunction(const Storage& callable, Args&&... args)
+		{
+			return function_impl::InvokeR<ReturnType>(
+				reinterpret_cast<TPointer>(callable.Function), std::forward<Args>(args)...);
+		}
+
+		template <typename TMember>
+		static ReturnType InvokeMember(const Storage& callable, Args&&... args)
+		{
+			TMember member;
+			std::memcpy(&member, callable.Member, sizeof(TMember));
+			return function_impl::InvokeR<ReturnType>(member, std::forward<Args>(args)...);
+		}
+
+		Storage Callable;
+		ReturnType (*Invoker)(const Storage&, Args&&...);
+	};
+
+	template <typename TFunc>
+	FunctionRef(TFunc&&) -> FunctionRef<typename traits::FunctorTraits<TFunc>::TSignature>;
+
+	template <typename TSignature, size_t Bytes = 48, bool Copyable = true>
+	struct InplaceFunction;
+
+	// InplaceFunction that takes move only callables (lambdas owning a unique_ptr, ...) and is move only itself
+	template <typename TSignature, size_t Bytes = 48>
+	using InplaceMoveFunction = InplaceFunction<TSignature, Bytes, false>;
+
+	// owning: the callable is built in Bytes of inline storage, one that does not fit is a compile error
+	// rather than a hidden allocation. the default Bytes make the whole object one 64 byte cache line.
+	// trivially copyable callables (lambdas capturing pointers, references and numbers) are copied and
+	// moved as raw bytes, others through a per type table like Union's. a copyable InplaceFunction does
+	// not accept a move only callable, InplaceMoveFunction does and has no copy operations
+	template <typename ReturnType, typename... Args, size_t Bytes, bool Copyable>
+	struct InplaceFunction<ReturnType(Args...), Bytes, Copyable>
+	{
+		static constexpr size_t kBytes = Bytes;
+		static constexpr size_t kAlign = alignof(std::max_align_t);
+
+		InplaceFunction() noexcept = default;
+		InplaceFunction(std::nullptr_t) noexcept {}
+
+		template <typename TFunc>
+			requires(!function_impl::IsSelf<TFunc, InplaceFunction> &&
+					 std::is_invocable_r_v<ReturnType, std::decay_t<TFunc>&, Args...> &&
+					 (!Copyable || std::is_copy_constructible_v<std::decay_t<TFunc>>))
+		InplaceFunction(TFunc&& func)
+		{
+			using TCallable = std::decay_t<TFunc>;
+			static_assert(sizeof(TCallable) <= Bytes, "callable does not fit this InplaceFunction, raise Bytes");
+			static_assert(alignof(TCallable) <= kAlign, "callable is over-aligned for InplaceFunction");
+
+			new (Storage) TCallable(std::forward<TFunc>(func));
+			Invoker = &Invoke<TCallable>;
+			if constexpr (!std::is_trivially_copyable_v<TCallable>)
+				Table = &gTables<TCallable>;
+		}
+
+		InplaceFunction(const InplaceFunction& other)
+			requires Copyable
+		{
+			CopyFrom(other);
+		}
+		InplaceFunction(InplaceFunction&& other) noexcept { MoveFrom(other); }
+		~InplaceFunction() { Reset(); }
+
+		InplaceFunction& operator=(const InplaceFunction& other)
+			requires Copyable
+		{
+			if (this != &other)
+			{
+				Reset();
+				CopyFrom(other);
+			}
+			return *this;
+		}
+		InplaceFunction& operator=(InplaceFunction&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Reset();
+				MoveFrom(other);
+			}
+			return *this;
+		}
+		InplaceFunction& operator=(std::nullptr_t) noexcept
+		{
+			Reset();
+			return *this;
+		}
+
+		// calls through a const InplaceFunction may still change a mutable lambda's captures, as std::function
+		ReturnType operator()(Args... args) const
+		{
+			assert(Invoker);
+			return Invoker(Storage, std::forward<Args>(args)...);
+		}
+
+		explicit operator bool() const noexcept { return Invoker != nullptr; }
+
+		void Reset() noexcept
+		{
+			if (Table)
+				Table->Destructor(Storage);
+			Invoker = nullptr;
+			Table = nullptr;
+		}
+
+	private:
+		struct MethodTable
+		{
+			void (*CopyConstruct)(void* self, const void* other); // null in InplaceMoveFunction
+			void (*MoveConstruct)(void* self, void* other);		  // also destroys other
+			void (*Destructor)(void* self);
+		};
+
+		template <typename TCallable>
+		static ReturnType Invoke(void* storage, Args&&... args)
+		{
+			return function_impl::InvokeR<ReturnType>(*static_cast<TCallable*>(storage), std::forward<Args>(args)...);
+		}
+
+		template <typename TCallable>
+		static constexpr MethodTable BuildMethodTable()
+		{
+			auto table = MethodTable();
+			if constexpr (Copyable)
+			{
+				table.CopyConstruct = [](void* self, const void* other) {
+					new (self) TCallable(*static_cast<const TCallable*>(other));
+				};
+			}
+			table.MoveConstruct = [](void* self, void* other) {
+				new (self) TCallable(std::move(*static_cast<TCallable*>(other)));
+				static_cast<TCallable*>(other)->~TCallable();
+			};
+			table.Destructor = [](void* self) { static_cast<TCallable*>(self)->~TCallable(); };
+			return table;
+		}
+
+		template <typename TCallable>
+		static constexpr MethodTable gTables = BuildMethodTable<TCallable>();
+
+		void CopyFrom(const InplaceFunction& other)
+		{
+			if (other.Table)
+				other.Table->CopyConstruct(Storage, other.Storage);
+			else if (other.Invoker)
+			{
+				std::memcpy(Storage, other.Storage, Bytes);
+			}
+			Invoker = other.Invoker;
+			Table = other.Table;
+		}
+
+		void MoveFrom(InplaceFunction& other) noexcept
+		{
+			if (other.Table)
+				other.Table->MoveConstruct(Storage, other.Storage);
+			else if (other.Invoker)
+				std::memcpy(Storage, other.Storage, Bytes);
+			Invoker = other.Invoker;
+			Table = other.Table;
+			other.Invoker = nullptr;
+			other.Table = nullptr;
+		}
+
+		ReturnType (*Invoker)(void*, Args&&...) = nullptr;
+		const MethodTable* Table = nullptr; // null when the callable is trivially copyable
+		alignas(kAlign) mutable byte Storage[Bytes];
+	};
+
+	template <typename TFunc>
+	InplaceFunction(TFunc&&) -> InplaceFunction<typename traits::FunctorTraits<TFunc>::TSignature>;
+} // namespace vex
@@ -0,0 +1,133 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for Function.h, from the repository root:
+//	g++ -std=c++20 -pthread -fsanitize=address -I. union/Function.test.cpp -o function_test && ./function_test
+// under -fsanitize=address a FunctionRef left pointing at a dead temporary is reported as use after scope
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "Function.h"
+#include "ThreadPool.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using vex::FunctionRef;
+using vex::InplaceFunction;
+using vex::InplaceMoveFunction;
+
+namespace
+{
+	struct Counter
+	{
+		int Get() const { return Value; }
+		int Add(int amount) { return Value += amount; }
+		int Value = 0;
+	};
+
+	using MoveOnly = decltype([owner = std::unique_ptr<int>()] { return owner != nullptr; });
+
+	// a move only callable cannot reach a copyable InplaceFunction, so a copy can never find it
+	static_assert(!std::is_constructible_v<InplaceFunction<bool()>, MoveOnly>);
+	static_assert(std::is_constructible_v<InplaceMoveFunction<bool()>, MoveOnly>);
+	static_assert(!std::is_copy_constructible_v<InplaceMoveFunction<bool()>>);
+	static_assert(!std::is_copy_assignable_v<InplaceMoveFunction<bool()>>);
+	static_assert(std::is_nothrow_move_constructible_v<InplaceMoveFunction<bool()>>);
+	static_assert(std::is_copy_constructible_v<InplaceFunction<bool()>>);
+	static_assert(sizeof(InplaceFunction<void()>) == 64);
+	static_assert(std::is_trivially_copyable_v<FunctionRef<void()>>);
+
+	int Twice(int x) { return 2 * x; }
+
+	void CheckFunctionRef()
+	{
+		const FunctionRef<int(int)> function = Twice;
+		const FunctionRef<int(int)> pointer = &Twice;
+		int captured = 3;
+		auto lambda = [&captured](int x) { return x + captured; };
+		const FunctionRef<int(int)> object = lambda;
+		VEX_CHECK(function(4) == 8 && pointer(5) == 10 && object(1) == 4);
+
+		// member pointers are prvalues here, they are copied in rather than referenced
+		const FunctionRef<int(const Counter&)> get = &Counter::Get;
+		const FunctionRef<int(Counter&, int)> add = &Counter::Add;
+		const FunctionRef<int&(Counter&)> field = &Counter::Value;
+		Counter counter;
+		add(counter, 5);
+		field(counter) += 1;
+		VEX_CHECK(get(counter) == 6 && counter.Value == 6);
+
+		// deduced from the callable
+		FunctionRef deduced = lambda;
+		static_assert(std::is_same_v<decltype(deduced), FunctionRef<int(int)>>);
+		VEX_CHECK(deduced(0) == 3);
+	}
+
+	void CheckInplaceFunction()
+	{
+		// trivially copyable captures are copied as bytes, the string goes through the type's table
+		int calls = 0;
+		InplaceFunction<int()> counting = [&calls] { return ++calls; };
+		InplaceFunction<int()> copy = counting;
+		copy();
+		counting();
+		VEX_CHECK(calls == 2);
+
+		InplaceFunction<size_t(const std::string&)> append = [prefix = std::string(30, 'p')](const std::string& s) {
+			return prefix.size() + s.size();
+		};
+		InplaceFunction<size_t(const std::string&)> appendCopy = append;
+		VEX_CHECK(append("ab") == 32 && appendCopy("abc") == 33);
+		appendCopy = nullptr;
+		VEX_CHECK(!appendCopy && append);
+
+		// mutable state lives inside the InplaceFunction
+		InplaceFunction<int()> sequence = [next = 0]() mutable { return next++; };
+		sequence();
+		VEX_CHECK(sequence() == 1);
+		InplaceFunction<int()> moved = std::move(sequence);
+		VEX_CHECK(!sequence && moved() == 2);
+
+		auto owner = std::make_unique<int>(7);
+		InplaceMoveFunction<int()> owning = [owner = std::move(owner)] { return *owner; };
+		InplaceMoveFunction<int()> taken = std::move(owning);
+		VEX_CHECK(!owning && taken() == 7);
+		owning = std::move(taken);
+		VEX_CHECK(owning() == 7);
+
+		// copyable callables are fine in the move only flavour too
+		InplaceMoveFunction<int(int)> plain = Twice;
+		VEX_CHECK(plain(21) == 42);
+	}
+
+	void CheckPoolJobs()
+	{
+		// pool jobs are InplaceMoveFunction, so they may own their captures
+		vex::ThreadPool pool(2);
+		std::atomic<int> sum = 0;
+		{
+			vex::JobGroup group(pool);
+			for (int i = 1; i <= 10; ++i)
+				group.Run([&sum, value = std::make_unique<int>(i)] { sum += *value; });
+		}
+		VEX_CHECK(sum == 55);
+	}
+} // namespace
+
+int main()
+{
+	CheckFunctionRef();
+	CheckInplaceFunction();
+	CheckPoolJobs();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// vex::HashMap against std::unordered_map, from the repository root:
+//	g++ -std=c++20 -O2 -march=native -DNDEBUG -I. union/HashMap.bench.cpp -o hashmap_bench
+// prints ns per operation, best of 3, for insert / find hit / find miss / erase at 1K to 1M keys
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "HashMap.h"
+
+namespace
+{
+	// keeps results alive so the measured loops are not optimised out
+	volatile u64 gSink = 0;
+
+	template <typename TFunc>
+	double NsPerOp(size_t ops, TFunc&& func)
+	{
+		double best = 1e30;
+		for (int run = 0; run < 3; ++run)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			func();
+			const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+			best = elapsed.count() < best ? elapsed.count() : best;
+		}
+		return best / (double)ops;
+	}
+
+	struct Row
+	{
+		double Insert, FindHit, FindMiss, Erase;
+	};
+
+	template <typename TMap, typename TKey, typename TFind, typename TInsert, typename TErase>
+	Row Measure(const std::vector<TKey>& keys, const std::vector<TKey>& misses, TInsert insert, TFind find, TErase erase)
+	{
+		Row row;
+		const size_t n = keys.size();
+		row.Insert = NsPerOp(n, [&] {
+			TMap map;
+			for (size_t i = 0; i < n; ++i)
+				insert(map, keys[i], (u32)i);
+			gSink = gSink + (u64)find(map, keys[0]);
+		});
+
+		TMap map;
+		for (size_t i = 0; i < n; ++i)
+			insert(map, keys[i], (u32)i);
+		row.FindHit = NsPerOp(n, [&] {
+			u64 sum = 0;
+			for (const TKey& key : keys)
+				sum += find(map, key);
+			gSink = gSink + sum;
+		});
+		row.FindMiss = NsPerOp(n, [&] {
+			u64 sum = 0;
+			for (const TKey& key : misses)
+				sum += find(map, key);
+			gSink = gSink + sum;
+		});
+		// every run erases from a fresh copy, the copy alone is timed and taken off
+		const double copyOnly = NsPerOp(n, [&] {
+			TMap copy = map;
+			gSink = gSink + (u64)find(copy, keys[0]);
+		});
+		row.Erase = NsPerOp(n, [&] {
+			TMap copy = map;
+			for (const TKey& key : keys)
+				erase(copy, key);
+			gSink = gSink + (u64)find(copy, keys[0]);
+		}) - copyOnly;
+		return row;
+	}
+
+	void Print(const char* name, size_t n, const Row& row)
+	{
+		std::printf("%-28s %9zu %8.1f %8.1f %8.1f %8.1f\n", name, n, row.Insert, row.FindHit, row.FindMiss, row.Erase);
+	}
+
+	void RunIntegers(size_t n)
+	{
+		std::mt19937_64 rng(n);
+		std::vector<u64> keys(n), misses(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			keys[i] = rng() | 1; // odd keys hit, even keys miss
+			misses[i] = rng() & ~u64(1);
+		}
+
+		using TVex = vex::HashMap<u64, u32>;
+		Print("vex::HashMap<u64>", n,
+			Measure<TVex>(
+				keys, misses, [](TVex& m, u64 k, u32 v) { m.TryEmplace(k, v); },
+				[](const TVex& m, u64 k) -> u32 {
+					const u32* v = m.Find(k);
+					return v ? *v : 0;
+				},
+				[](TVex& m, u64 k) { m.Erase(k); }));
+
+		using TStd = std::unordered_map<u64, u32>;
+		Print("std::unordered_map<u64>", n,
+			Measure<TStd>(
+				keys, misses, [](TStd& m, u64 k, u32 v) { m.try_emplace(k, v); },
+				[](const TStd& m, u64 k) -> u32 {
+					auto it = m.find(k);
+					return it != m.end() ? it->second : 0;
+				},
+				[](TStd& m, u64 k) { m.erase(k); }));
+	}
+
+	void RunStrings(size_t n)
+	{
+		std::mt19937_64 rng(n);
+		std::vector<std::string> keys(n), misses(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			keys[i] = "key/" + std::to_string(rng()) + "/hit";
+			misses[i] = "key/" + std::to_string(rng()) + "/miss";
+		}
+
+		using TVex = vex::HashMap<std::string, u32>;
+		Print("vex::HashMap<string>", n,
+			Measure<TVex>(
+				keys, misses, [](TVex& m, const std::string& k, u32 v) { m.TryEmplace(k, v); },
+				[](const TVex& m, const std::string& k) -> u32 {
+					const u32* v = m.Find(k);
+					return v ? *v : 0;
+				},
+				[](TVex& m, const std::string& k) { m.Erase(k); }));
+
+		using TStd = std::unordered_map<std::string, u32>;
+		Print("std::unordered_map<string>", n,
+			Measure<TStd>(
+				keys, misses, [](TStd& m, const std::string& k, u32 v) { m.try_emplace(k, v); },
+				[](const TStd& m, const std::string& k) -> u32 {
+					auto it = m.find(k);
+					return it != m.end() ? it->second : 0;
+				},
+				[](TStd& m, const std::string& k) { m.erase(k); }));
+	}
+} // namespace
+
+int main()
+{
+	std::printf("%-28s %9s %8s %8s %8s %8s   (ns/op)\n", "map", "keys", "insert", "hit", "miss", "erase");
+	for (size_t n : {1000u, 64000u, 1000000u})
+		RunIntegers(n);
+	for (size_t n : {1000u, 64000u, 1000000u})
+		RunStrings(n);
+	return 0;
+}
@@ -0,0 +1,443 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <cassert>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VEX_HASHMAP_SSE2 1
+#else
+#define VEX_HASHMAP_SSE2 0
+#endif
+
+#include "CoreTemplates.h"
+#include "HashUtils.h"
+
+namespace vex
+{
+	namespace hashmap_impl
+	{
+		// control byte per slot: empty / deleted have the sign bit set, full slots store 7 bits of hash (H2)
+		static constexpr i8 kEmpty = -128;
+		static constexpr i8 kDeleted = -2;
+		static constexpr u32 kGroupWidth = 16;
+		// capacities are powers of two counted in u32
+		static constexpr u32 kMaxCapacity = 1u << 31;
+
+		constexpr u32 MaxLoad(u32 capacity) { return capacity - capacity / 8; }
+
+		// smallest capacity, at least one group, that holds count entries. 0 when no u32 capacity does
+		constexpr u32 CapacityFor(u32 count)
+		{
+			u64 capacity = kGroupWidth; // in u64 so doubling past kMaxCapacity cannot wrap to 0
+			while (capacity - capacity / 8 < count)
+				capacity *= 2;
+			return capacity <= kMaxCapacity ? (u32)capacity : 0;
+		}
+
+		inline u32 TrailingZeros(u32 mask)
+		{
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return (u32)index;
+#else
+			return (u32)__builtin_ctz(mask);
+#endif
+		}
+
+		// 16 control bytes examined at once, each query returns one bit per matching slot
+		struct Group
+		{
+#if VEX_HASHMAP_SSE2
+			explicit Group(const i8* ctrl) : Ctrl(_mm_load_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+			u32 Match(i8 h2) const { return (u32)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), Ctrl)); }
+			u32 MatchEmpty() const { return Match(kEmpty); }
+			u32 MatchEmptyOrDeleted() const { return (u32)_mm_movemask_epi8(Ctrl); }
+
+			__m128i Ctrl;
+#else
+			explicit Group(const i8* ctrl) { std::memcpy(Ctrl, ctrl, kGroupWidth); }
+
+			u32 Match(i8 h2) const
+			{
+				u32 mask = 0;
+				for (u32 i = 0; i < kGroupWidth; ++i)
+					mask |= (u32)(Ctrl[i] == h2) << i;
+				return mask;
+			}
+			u32 MatchEmpty() const { return Match(kEmpty); }
+			u32 MatchEmptyOrDeleted() const
+			{
+				u32 mask = 0;
+				for (u32 i = 0; i < kGroupWidth; ++i)
+					mask |= (u32)(Ctrl[i] < 0) << i;
+				return mask;
+			}
+
+			i8 Ctrl[kGroupWidth];
+#endif
+		};
+	} // namespace hashmap_impl
+
+	// flat open addressing map, SwissTable layout: a control byte array probed 16 slots at a time,
+	// entries stored inline in a parallel array. max load 7/8.
+	// erase only leaves a tombstone when the slot's group is full, tombstones are dropped on the next rehash.
+	// std::string keys can be looked up by std::string_view / const char* without building a string.
+	template <typename K, typename V, typename THashPolicy = util::SHash_MURMUR>
+	struct HashMap
+	{
+		struct Entry
+		{
+			K Key;
+			V Value;
+		};
+
+		static constexpr bool kStringKey = std::is_convertible_v<const K&, std::string_view>;
+
+		// what a lookup argument is converted to before hashing, so hash(key) == hash(K(key))
+		template <typename TKey>
+		using LookupT = std::conditional_t<kStringKey && std::is_convertible_v<const TKey&, std::string_view>,
+			std::string_view, K>;
+
+		HashMap() = default;
+		explicit HashMap(u32 capacity) { Reserve(capacity); }
+		HashMap(const HashMap& other)
+		{
+			Reserve(other.Size);
+			for (const Entry& entry : other)
+				TryEmplace(entry.Key, entry.Value);
+		}
+		HashMap(HashMap&& other) noexcept { Swap(other); }
+		~HashMap() { Release(); }
+
+		HashMap& operator=(const HashMap& other)
+		{
+			if (this != &other)
+			{
+				HashMap copy(other);
+				Swap(copy);
+			}
+			return *this;
+		}
+		HashMap& operator=(HashMap&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Release();
+				Swap(other);
+			}
+			return *this;
+		}
+
+		u32 Count() const noexcept { return Size; }
+		u32 GetCapacity() const noexcept { return Capacity; }
+		bool IsEmpty() const noexcept { return Size == 0; }
+
+		template <typename TKey>
+		V* Find(const TKey& key) noexcept
+		{
+			const u32 slot = FindSlot(static_cast<const LookupT<TKey>&>(key));
+			return slot != kNone ? &Slots[slot].Value : nullptr;
+		}
+		template <typename TKey>
+		const V* Find(const TKey& key) const noexcept
+		{
+			return const_cast<HashMap*>(this)->Find(key);
+		}
+		template <typename TKey>
+		bool Contains(const TKey& key) const noexcept
+		{
+			return Find(key) != nullptr;
+		}
+
+		// returns {value, true} if inserted, {existing value, false} if key was present
+		template <typename TKey, typename... TArgs>
+		std::pair<V*, bool> TryEmplace(TKey&& key, TArgs&&... args)
+		{
+			const LookupT<std::decay_t<TKey>>& lookup = key;
+			const u32 hash = HashOf(lookup);
+			u32 slot = FindSlot(lookup, hash);
+			if (slot != kNone)
+				return {&Slots[slot].Value, false};
+
+			slot = PrepareInsert(hash);
+			new (&Slots[slot]) Entry{K(std::forward<TKey>(key)), V(std::forward<TArgs>(args)...)};
+			ClaimSlot(slot, hash);
+			return {&Slots[slot].Value, true};
+		}
+
+		template <typename TKey, typename TValue>
+		V& InsertOrAssign(TKey&& key, TValue&& value)
+		{
+			auto [existing, inserted] = TryEmplace(std::forward<TKey>(key), std::forward<TValue>(value));
+			if (!inserted)
+				*existing = std::forward<TValue>(value);
+			return *existing;
+		}
+
+		template <typename TKey>
+		V& operator[](TKey&& key)
+		{
+			return *TryEmplace(std::forward<TKey>(key)).first;
+		}
+
+		template <typename TKey>
+		bool Erase(const TKey& key)
+		{
+			const u32 slot = FindSlot(static_cast<const LookupT<TKey>&>(key));
+			if (slot == kNone)
+				return false;
+
+			Slots[slot].~Entry();
+			--Size;
+			// a group that still has an empty slot never made a probe sequence continue past it
+			const u32 groupStart = slot & ~(hashmap_impl::kGroupWidth - 1);
+			if (hashmap_impl::Group(Ctrl + groupStart).MatchEmpty() != 0)
+			{
+				Ctrl[slot] = hashmap_impl::kEmpty;
+				++GrowthLeft;
+			}
+			else
+			{
+				Ctrl[slot] = hashmap_impl::kDeleted;
+			}
+			return true;
+		}
+
+		void Reserve(u32 count)
+		{
+			const u32 needed = CapacityFor(count);
+			if (needed > Capacity)
+				Rehash(needed);
+		}
+
+		void Clear()
+		{
+			DestroyEntries();
+			if (Capacity)
+				std::memset(Ctrl, (u8)hashmap_impl::kEmpty, Capacity);
+			Size = 0;
+			GrowthLeft = MaxLoad(Capacity);
+		}
+
+		void Swap(HashMap& other) noexcept
+		{
+			std::swap(Ctrl, other.Ctrl);
+			std::swap(Slots, other.Slots);
+			std::swap(Capacity, other.Capacity);
+			std::swap(Size, other.Size);
+			std::swap(GrowthLeft, other.GrowthLeft);
+		}
+
+		template <bool IsConst>
+		struct IteratorBase
+		{
+			using TMap = std::conditional_t<IsConst, const HashMap, HashMap>;
+			using TEntry = std::conditional_t<IsConst, const Entry, Entry>;
+
+			TEntry& operator*() const { return Map->Slots[Index]; }
+			TEntry* operator->() const { return &Map->Slots[Index]; }
+			IteratorBase& operator++()
+			{
+				++Index;
+				SkipEmpty();
+				return *this;
+			}
+			bool operator==(const IteratorBase& other) const { return Index == other.Index; }
+			bool operator!=(const IteratorBase& other) const { return Index != other.Index; }
+
+			void SkipEmpty()
+			{
+				while (Index < Map->Capacity && Map->Ctrl[Index] < 0)
+					++Index;
+			}
+
+			TMap* Map;
+			u32 Index;
+		};
+		using Iterator = IteratorBase<false>;
+		using ConstIterator = IteratorBase<true>;
+
+		Iterator begin() noexcept
+		{
+			Iterator it{this, 0};
+			it.SkipEmpty();
+			return it;
+		}
+		Iterator end() noexcept { return Iterator{this, Capacity}; }
+		ConstIterator begin() const noexcept
+		{
+			ConstIterator it{this, 0};
+			it.SkipEmpty();
+			return it;
+		}
+		ConstIterator end() const noexcept { return ConstIterator{this, Capacity}; }
+
+	private:
+		static constexpr u32 kNone = 0xffffffffu;
+
+		template <typename TKey>
+		static u32 HashOf(const TKey& key)
+		{
+			return (u32)util::HashValue<THashPolicy>(key);
+		}
+		static i8 H2(u32 hash) { return (i8)(hash & 0x7f); }
+		static u32 H1(u32 hash) { return hash >> 7; }
+
+		static u32 MaxLoad(u32 capacity) { return hashmap_impl::MaxLoad(capacity); }
+		static u32 CapacityFor(u32 count)
+		{
+			const u32 capacity = hashmap_impl::CapacityFor(count);
+			assert(capacity != 0 && "HashMap cannot hold that many entries");
+			return capacity;
+		}
+
+		// triangular probing over groups, visits every group once for power of two group counts
+		struct ProbeSeq
+		{
+			ProbeSeq(u32 hash, u32 groupMask) : Mask(groupMask), Group(H1(hash) & groupMask) {}
+			u32 Offset() const { return Group * hashmap_impl::kGroupWidth; }
+			void Next()
+			{
+				++Step;
+				Group = (Group + Step) & Mask;
+			}
+			u32 Mask;
+			u32 Group;
+			u32 Step = 0;
+		};
+
+		template <typename TKey>
+		u32 FindSlot(const TKey& key) const
+		{
+			return Capacity ? FindSlot(key, HashOf(key)) : kNone;
+		}
+
+		template <typename TKey>
+		u32 FindSlot(const TKey& key, u32 hash) const
+		{
+			if (Capacity == 0)
+				return kNone;
+			const i8 h2 = H2(hash);
+			for (ProbeSeq seq(hash, Capacity / hashmap_impl::kGroupWidth - 1);; seq.Next())
+			{
+				const hashmap_impl::Group group(Ctrl + seq.Offset());
+				for (u32 match = group.Match(h2); match != 0; match &= match - 1)
+				{
+					const u32 slot = seq.Offset() + hashmap_impl::TrailingZeros(match);
+					if (Slots[slot].Key == key)
+						return slot;
+				}
+				if (group.MatchEmpty() != 0)
+					return kNone;
+			}
+		}
+
+		u32 FindInsertSlot(u32 hash) const
+		{
+			for (ProbeSeq seq(hash, Capacity / hashmap_impl::kGroupWidth - 1);; seq.Next())
+			{
+				const u32 free = hashmap_impl::Group(Ctrl + seq.Offset()).MatchEmptyOrDeleted();
+				if (free != 0)
+					return seq.Offset() + hashmap_impl::TrailingZeros(free);
+			}
+		}
+
+		// finds the slot for a new key, grows or drops tombstones when out of budget. the slot stays free
+		// until ClaimSlot, so an entry constructor that throws leaves the table as it was
+		u32 PrepareInsert(u32 hash)
+		{
+			if (Capacity == 0)
+				Rehash(hashmap_impl::kGroupWidth);
+
+			u32 slot = FindInsertSlot(hash);
+			if (GrowthLeft == 0 && Ctrl[slot] == hashmap_impl::kEmpty)
+			{
+				// mostly tombstones -> rebuild at the same size, otherwise double
+				assert((Size < MaxLoad(Capacity) / 2 || Capacity < hashmap_impl::kMaxCapacity) && "HashMap is full");
+				Rehash(Size < MaxLoad(Capacity) / 2 ? Capacity : Capacity * 2);
+				slot = FindInsertSlot(hash);
+			}
+			return slot;
+		}
+
+		// marks slot full once its entry is constructed
+		void ClaimSlot(u32 slot, u32 hash)
+		{
+			if (Ctrl[slot] == hashmap_impl::kEmpty)
+				--GrowthLeft;
+			Ctrl[slot] = H2(hash);
+			++Size;
+		}
+
+		void Rehash(u32 newCapacity)
+		{
+			i8* oldCtrl = Ctrl;
+			Entry* oldSlots = Slots;
+			const u32 oldCapacity = Capacity;
+
+			Ctrl = static_cast<i8*>(::operator new(newCapacity, std::align_val_t(hashmap_impl::kGroupWidth)));
+			Slots = static_cast<Entry*>(::operator new(sizeof(Entry) * newCapacity, std::align_val_t(alignof(Entry))));
+			std::memset(Ctrl, (u8)hashmap_impl::kEmpty, newCapacity);
+			Capacity = newCapacity;
+			GrowthLeft = MaxLoad(newCapacity) - Size;
+
+			for (u32 i = 0; i < oldCapacity; ++i)
+			{
+				if (oldCtrl[i] < 0)
+					continue;
+				const u32 hash = HashOf(oldSlots[i].Key);
+				const u32 slot = FindInsertSlot(hash);
+				Ctrl[slot] = H2(hash);
+				new (&Slots[slot]) Entry(std::move(oldSlots[i]));
+				oldSlots[i].~Entry();
+			}
+			Free(oldCtrl, oldSlots);
+		}
+
+		void DestroyEntries()
+		{
+			if constexpr (!std::is_trivially_destructible_v<Entry>)
+			{
+				for (u32 i = 0; i < Capacity; ++i)
+				{
+					if (Ctrl[i] >= 0)
+						Slots[i].~Entry();
+				}
+			}
+		}
+
+		static void Free(i8* ctrl, Entry* slots)
+		{
+			if (ctrl)
+				::operator delete(ctrl, std::align_val_t(hashmap_impl::kGroupWidth));
+			if (slots)
+				::operator delete(slots, std::align_val_t(alignof(Entry)));
+		}
+
+		void Release()
+		{
+			DestroyEntries();
+			Free(Ctrl, Slots);
+			Ctrl = nullptr;
+			Slots = nullptr;
+			Capacity = 0;
+			Size = 0;
+			GrowthLeft = 0;
+		}
+
+		i8* Ctrl = nullptr;
+		Entry* Slots = nullptr;
+		u32 Capacity = 0;
+		u32 Size = 0;
+		u32 GrowthLeft = 0; // empty slots that may still be claimed before a rehash
+	};
+} // namespace vex
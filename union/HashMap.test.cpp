@@ -0,0 +1,124 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for HashMap.h against std::unordered_map, from the repository root:
+//	g++ -std=c++20 -I. union/HashMap.test.cpp -o hashmap_test && ./hashmap_test
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "HashMap.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+namespace
+{
+	// throws from its constructor on demand
+	struct Fragile
+	{
+		static inline bool sThrow = false;
+		explicit Fragile(int value) : Value(value)
+		{
+			if (sThrow)
+				throw std::runtime_error("Fragile");
+		}
+		int Value;
+	};
+
+	// capacities fit the load limit, and counts no u32 capacity can hold give 0 instead of looping
+	using vex::hashmap_impl::CapacityFor;
+	using vex::hashmap_impl::kMaxCapacity;
+	using vex::hashmap_impl::MaxLoad;
+	static_assert(CapacityFor(0) == 16 && CapacityFor(14) == 16 && CapacityFor(15) == 32 && CapacityFor(29) == 64);
+	static_assert(CapacityFor(900000) == (1u << 20) && MaxLoad(1u << 20) >= 900000 && MaxLoad(1u << 19) < 900000);
+	static_assert(CapacityFor(MaxLoad(kMaxCapacity)) == kMaxCapacity);
+	static_assert(CapacityFor(MaxLoad(kMaxCapacity) + 1) == 0 && CapacityFor(0xffffffffu) == 0);
+
+	void CheckAgainstStd()
+	{
+		vex::HashMap<u64, u64> map;
+		std::unordered_map<u64, u64> expected;
+		std::mt19937_64 rng(7);
+		for (int i = 0; i < 200000; ++i)
+		{
+			const u64 key = rng() % 5000;
+			switch (rng() % 3)
+			{
+			case 0:
+				VEX_CHECK(map.TryEmplace(key, key * 3).second == expected.try_emplace(key, key * 3).second);
+				break;
+			case 1:
+				VEX_CHECK(map.Erase(key) == (expected.erase(key) == 1));
+				break;
+			default:
+			{
+				const u64* found = map.Find(key);
+				auto it = expected.find(key);
+				VEX_CHECK((found != nullptr) == (it != expected.end()));
+				VEX_CHECK(!found || *found == it->second);
+			}
+			}
+		}
+		VEX_CHECK(map.Count() == expected.size());
+		u32 visited = 0;
+		for (const auto& entry : map)
+			visited += expected.count(entry.Key) == 1;
+		VEX_CHECK(visited == expected.size());
+	}
+
+	void CheckStringKeys()
+	{
+		vex::HashMap<std::string, int> map;
+		map["alpha"] = 1;
+		map.InsertOrAssign(std::string("beta"), 2);
+		VEX_CHECK(map.Contains(std::string_view("alpha")));
+		VEX_CHECK(map.Find("beta") && *map.Find("beta") == 2);
+		VEX_CHECK(!map.Contains("gamma"));
+		VEX_CHECK(map.Erase("alpha") && map.Count() == 1);
+	}
+
+	void CheckThrowingConstructor()
+	{
+		vex::HashMap<int, Fragile> map;
+		for (int i = 0; i < 10; ++i)
+			map.TryEmplace(i, i);
+
+		Fragile::sThrow = true;
+		bool threw = false;
+		try
+		{
+			map.TryEmplace(100, 100);
+		}
+		catch (const std::runtime_error&)
+		{
+			threw = true;
+		}
+		Fragile::sThrow = false;
+
+		VEX_CHECK(threw);
+		VEX_CHECK(map.Count() == 10);
+		VEX_CHECK(!map.Contains(100));
+		u32 visited = 0;
+		for (const auto& entry : map)
+			visited += entry.Value.Value == entry.Key;
+		VEX_CHECK(visited == 10);
+		VEX_CHECK(map.TryEmplace(100, 100).second && map.Find(100)->Value == 100);
+	}
+} // namespace
+
+int main()
+{
+	CheckAgainstStd();
+	CheckStringKeys();
+	CheckThrowingConstructor();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
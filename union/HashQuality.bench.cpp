@@ -0,0 +1,70 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// every hash policy through HashQuality.h, from the repository root:
+//	g++ -std=c++20 -O2 -march=native -DNDEBUG -I. union/HashQuality.bench.cpp -o hashquality
+//	./hashquality [key count, default 100000]
+// prints bucket statistics over MakeKeySets, then avalanche and throughput at kThroughputKeyLengths.
+// SHash_Fast is reported once per backend the cpu supports
+#include <cstdio>
+#include <cstdlib>
+
+#include "FastHash.h"
+#include "HashQuality.h"
+
+using namespace vex::util;
+using namespace vex::util::quality;
+
+namespace
+{
+	template <typename THashPolicy>
+	void Report(const char* policyName, const std::vector<KeySet>& sets)
+	{
+		for (const KeySet& set : sets)
+			PrintHashReport<THashPolicy>(policyName, set, stdout);
+		PrintSpeedReport<THashPolicy>(policyName, stdout);
+		std::printf("\n");
+	}
+
+	void ReportFast(const std::vector<KeySet>& sets)
+	{
+		static constexpr struct
+		{
+			FastHashBackend Backend;
+			const char* Name;
+		} kBackends[] = {{FastHashBackend::Scalar, "fast-scalar"}, {FastHashBackend::Crc32c, "fast-crc32c"},
+			{FastHashBackend::Aes, "fast-aes"}};
+
+		const FastHashBackend initial = ActiveFastHashBackend();
+		for (const auto& backend : kBackends)
+		{
+			if (!SetFastHashBackend(backend.Backend))
+			{
+				std::printf("%-12s not supported by this cpu\n\n", backend.Name);
+				continue;
+			}
+			Report<SHash_Fast>(backend.Name, sets);
+		}
+		SetFastHashBackend(initial);
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	const int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+	if (count <= 0)
+	{
+		std::printf("usage: %s [key count]\n", argv[0]);
+		return 1;
+	}
+	const std::vector<KeySet> sets = MakeKeySets(count);
+
+	Report<SHash>("SHash", sets);
+	Report<SHash_STD>("std", sets);
+	Report<SHash_FNV1a>("fnv1a", sets);
+	Report<SHash_MURMUR>("murmur3", sets);
+	Report<SHash_WY>("wyhash", sets);
+	ReportFast(sets);
+	return 0;
+}
@@ -0,0 +1,319 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "CoreTemplates.h"
+#include "HashUtils.h"
+
+// measurements used to choose between the HashUtils policies, any policy with
+// a static Hash(std::string_view) works:
+//	for (const auto& set : MakeKeySets(100000))
+//		PrintHashReport<SHash_FNV1a>("fnv1a", set, stdout);
+namespace vex::util::quality
+{
+	struct KeySet
+	{
+		const char* Name = "";
+		std::vector<std::string> Keys;
+	};
+
+	namespace quality_impl
+	{
+		static constexpr const char* kSyllables[] = {"the", "an", "re", "in", "er", "on", "at", "en", "nd", "ti",
+			"es", "or", "te", "of", "ed", "is", "it", "al", "ar", "st", "to", "nt", "ng", "se", "ha", "as", "ou", "io",
+			"le", "ve", "co", "me", "de", "hi", "ri", "ro", "ic", "ne", "ea", "ra", "ce", "li", "ch", "ll", "be", "ma"};
+		static constexpr int kSyllableCount = sizeof(kSyllables) / sizeof(kSyllables[0]);
+
+		static constexpr const char* kPathDirs[] = {"src", "include", "engine", "render", "core", "tools", "assets",
+			"shaders", "textures", "audio", "ui", "tests"};
+		static constexpr int kPathDirCount = sizeof(kPathDirs) / sizeof(kPathDirs[0]);
+
+		static constexpr const char* kPathExtensions[] = {".cpp", ".h", ".png", ".json", ".hlsl", ".wav"};
+		static constexpr int kPathExtensionCount = sizeof(kPathExtensions) / sizeof(kPathExtensions[0]);
+
+		inline std::string ToBytes(u32 value) { return std::string((const char*)&value, sizeof(value)); }
+
+		template <typename THashPolicy>
+		inline u32 HashOf(std::string_view key)
+		{
+			return (u32)THashPolicy::Hash(key);
+		}
+	} // namespace quality_impl
+
+	// little endian 32 bit integers 0..count-1, the pattern that clusters weak hashes
+	inline KeySet MakeSequentialKeys(int count)
+	{
+		KeySet set{"sequential-int", {}};
+		set.Keys.reserve(count);
+		for (int i = 0; i < count; ++i)
+			set.Keys.push_back(quality_impl::ToBytes((u32)i));
+		return set;
+	}
+
+	// canonical 36 character version 4 UUID strings
+	inline KeySet MakeUuidKeys(int count, u64 seed = 1)
+	{
+		static constexpr char kHex[] = "0123456789abcdef";
+		Xoshiro256ss rng(seed);
+		KeySet set{"uuid", {}};
+		set.Keys.reserve(count);
+		for (int i = 0; i < count; ++i)
+		{
+			std::string key(36, '-');
+			for (int c = 0; c < 36; ++c)
+			{
+				if (c == 8 || c == 13 || c == 18 || c == 23)
+					continue;
+				key[c] = kHex[rng.Bounded(16)];
+			}
+			key[14] = '4';
+			key[19] = kHex[8 + rng.Bounded(4)];
+			set.Keys.push_back(std::move(key));
+		}
+		return set;
+	}
+
+	// "dir/dir/name_N.ext" style paths sharing long prefixes
+	inline KeySet MakePathKeys(int count, u64 seed = 2)
+	{
+		using namespace quality_impl;
+		Xoshiro256ss rng(seed);
+		KeySet set{"file-path", {}};
+		set.Keys.reserve(count);
+		for (int i = 0; i < count; ++i)
+		{
+			std::string key;
+			const u32 depth = 1 + rng.Bounded(4);
+			for (u32 d = 0; d < depth; ++d)
+			{
+				key += kPathDirs[rng.Bounded(kPathDirCount)];
+				key += '/';
+			}
+			key += kSyllables[rng.Bounded(kSyllableCount)];
+			key += '_';
+			key += std::to_string(i);
+			key += kPathExtensions[rng.Bounded(kPathExtensionCount)];
+			set.Keys.push_back(std::move(key));
+		}
+		return set;
+	}
+
+	// unique english-like words glued from common bigram syllables, 2-12 characters.
+	// no dictionary ships with the repo so the short, low entropy shape is synthesized
+	inline KeySet MakeWordKeys(int count, u64 seed = 3)
+	{
+		using namespace quality_impl;
+		Xoshiro256ss rng(seed);
+		KeySet set{"english-word", {}};
+		set.Keys.reserve(count);
+		while ((int)set.Keys.size() < count)
+		{
+			std::string key;
+			const u32 syllables = 1 + rng.Bounded(6);
+			for (u32 s = 0; s < syllables; ++s)
+				key += kSyllables[rng.Bounded(kSyllableCount)];
+			set.Keys.push_back(std::move(key));
+			if ((int)set.Keys.size() == count)
+			{
+				std::sort(set.Keys.begin(), set.Keys.end());
+				set.Keys.erase(std::unique(set.Keys.begin(), set.Keys.end()), set.Keys.end());
+			}
+		}
+		return set;
+	}
+
+	inline std::vector<KeySet> MakeKeySets(int count)
+	{
+		std::vector<KeySet> sets;
+		sets.push_back(MakeSequentialKeys(count));
+		sets.push_back(MakeUuidKeys(count));
+		sets.push_back(MakePathKeys(count));
+		sets.push_back(MakeWordKeys(count));
+		return sets;
+	}
+
+	struct BucketStats
+	{
+		int Buckets = 0;
+		int Keys = 0;
+		int EmptyBuckets = 0;
+		double ExpectedEmptyBuckets = 0.0;
+		int MaxLoad = 0;
+		// chi-square of bucket counts divided by its degrees of freedom, ~1.0 for a uniform hash
+		double NormalizedChiSquare = 0.0;
+		// keys whose full 32 bit hash equals another key's
+		int HashCollisions = 0;
+		double ExpectedHashCollisions = 0.0;
+	};
+
+	// distribution of keys over gPrimeNumbers[primeIndex] buckets, reduced with FastMod like prime sized tables
+	template <typename THashPolicy>
+	BucketStats MeasureBuckets(const std::vector<std::string>& keys, int primeIndex)
+	{
+		const u32 bucketCount = (u32)gPrimeNumbers[primeIndex];
+		std::vector<u32> counts(bucketCount);
+		std::vector<u32> hashes;
+		hashes.reserve(keys.size());
+		for (const std::string& key : keys)
+		{
+			const u32 hash = quality_impl::HashOf<THashPolicy>(key);
+			hashes.push_back(hash);
+			++counts[FastMod(hash, primeIndex)];
+		}
+
+		BucketStats stats;
+		stats.Buckets = (int)bucketCount;
+		stats.Keys = (int)keys.size();
+
+		const double expected = (double)keys.size() / bucketCount;
+		double chiSquare = 0.0;
+		for (const u32 count : counts)
+		{
+			stats.EmptyBuckets += count == 0;
+			stats.MaxLoad = std::max(stats.MaxLoad, (int)count);
+			chiSquare += (count - expected) * (count - expected) / expected;
+		}
+		stats.NormalizedChiSquare = bucketCount > 1 ? chiSquare / (bucketCount - 1) : 0.0;
+		stats.ExpectedEmptyBuckets = bucketCount * std::pow(1.0 - 1.0 / bucketCount, (double)keys.size());
+
+		std::sort(hashes.begin(), hashes.end());
+		for (size_t i = 1; i < hashes.size(); ++i)
+			stats.HashCollisions += hashes[i] == hashes[i - 1];
+		const double n = (double)keys.size();
+		stats.ExpectedHashCollisions = n * (n - 1) / 2.0 / 4294967296.0;
+		return stats;
+	}
+
+	struct AvalancheStats
+	{
+		int KeyLength = 0;
+		int Samples = 0;
+		// mean of |P(output bit flips) - 0.5| over all (input bit, output bit) pairs, 0 is ideal
+		double MeanBias = 0.0;
+		// worst single pair, a weak bit shows up here long before it moves the mean
+		double WorstBias = 0.0;
+	};
+
+	// flips every input bit of random keys of keyLength bytes and records which output bits change
+	template <typename THashPolicy>
+	AvalancheStats MeasureAvalanche(int keyLength, int samples = 10000, u64 seed = 4)
+	{
+		const int inputBits = keyLength * 8;
+		std::vector<u32> flips((size_t)inputBits * 32);
+		std::string key(keyLength, '\0');
+		Xoshiro256ss rng(seed);
+
+		for (int s = 0; s < samples; ++s)
+		{
+			for (char& c : key)
+				c = (char)rng.Next32();
+			const u32 base = quality_impl::HashOf<THashPolicy>(key);
+			for (int bit = 0; bit < inputBits; ++bit)
+			{
+				key[bit / 8] ^= (char)(1 << (bit % 8));
+				const u32 diff = base ^ quality_impl::HashOf<THashPolicy>(key);
+				key[bit / 8] ^= (char)(1 << (bit % 8));
+				u32* row = &flips[(size_t)bit * 32];
+				for (int out = 0; out < 32; ++out)
+					row[out] += (diff >> out) & 1;
+			}
+		}
+
+		AvalancheStats stats;
+		stats.KeyLength = keyLength;
+		stats.Samples = samples;
+		double total = 0.0;
+		for (const u32 count : flips)
+		{
+			const double bias = std::abs((double)count / samples - 0.5);
+			total += bias;
+			stats.WorstBias = std::max(stats.WorstBias, bias);
+		}
+		stats.MeanBias = flips.empty() ? 0.0 : total / flips.size();
+		return stats;
+	}
+
+	static constexpr int kThroughputKeyLengths[] = {4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096};
+
+	struct ThroughputStats
+	{
+		int KeyLength = 0;
+		double GigabytesPerSecond = 0.0;
+		double NanosecondsPerHash = 0.0;
+		// sum of all hashes, keeps the timed loop from being optimized away
+		u32 Checksum = 0;
+	};
+
+	// hashes about totalBytes of keyLength sized keys laid out back to back in a buffer that fits L2
+	template <typename THashPolicy>
+	ThroughputStats MeasureThroughput(int keyLength, size_t totalBytes = 256u << 20)
+	{
+		constexpr size_t kBufferBytes = 128u << 10;
+		const size_t keysInBuffer = std::max<size_t>(1, kBufferBytes / keyLength);
+		std::vector<char> buffer(keysInBuffer * keyLength);
+		Xoshiro256ss rng(5);
+		for (char& c : buffer)
+			c = (char)rng.Next32();
+
+		const size_t rounds = std::max<size_t>(1, totalBytes / buffer.size());
+		u32 sink = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (size_t r = 0; r < rounds; ++r)
+		{
+			for (size_t k = 0; k < keysInBuffer; ++k)
+				sink += quality_impl::HashOf<THashPolicy>(std::string_view(&buffer[k * keyLength], keyLength));
+		}
+		const auto end = std::chrono::steady_clock::now();
+
+		const double seconds = std::chrono::duration<double>(end - start).count();
+		const double hashes = (double)rounds * keysInBuffer;
+		ThroughputStats stats;
+		stats.KeyLength = keyLength;
+		stats.GigabytesPerSecond = seconds > 0.0 ? hashes * keyLength / seconds / 1e9 : 0.0;
+		stats.NanosecondsPerHash = hashes > 0.0 ? seconds * 1e9 / hashes : 0.0;
+		stats.Checksum = sink;
+		return stats;
+	}
+
+	// bucket statistics at a table sized to the key count and at 4x that, plus collisions
+	template <typename THashPolicy>
+	void PrintHashReport(const char* policyName, const KeySet& set, std::FILE* out)
+	{
+		const int count = (int)set.Keys.size();
+		for (const int primeIndex : {ClosestPrimeIndex(count), ClosestPrimeIndex(count * 4)})
+		{
+			const BucketStats stats = MeasureBuckets<THashPolicy>(set.Keys, primeIndex);
+			std::fprintf(out,
+				"%-12s %-16s keys %8d buckets %8d  chi2/df %6.3f  empty %8d (exp %10.1f)  max load %3d  "
+				"collisions %4d (exp %6.2f)\n",
+				policyName, set.Name, stats.Keys, stats.Buckets, stats.NormalizedChiSquare, stats.EmptyBuckets,
+				stats.ExpectedEmptyBuckets, stats.MaxLoad, stats.HashCollisions, stats.ExpectedHashCollisions);
+		}
+	}
+
+	// avalanche at small key sizes and throughput across kThroughputKeyLengths
+	template <typename THashPolicy>
+	void PrintSpeedReport(const char* policyName, std::FILE* out)
+	{
+		for (const int length : {4, 8, 16})
+		{
+			const AvalancheStats stats = MeasureAvalanche<THashPolicy>(length);
+			std::fprintf(out, "%-12s avalanche %4d B  mean bias %.4f  worst bias %.4f\n", policyName, length,
+				stats.MeanBias, stats.WorstBias);
+		}
+		for (const int length : kThroughputKeyLengths)
+		{
+			const ThroughputStats stats = MeasureThroughput<THashPolicy>(length);
+			std::fprintf(out, "%-12s throughput %4d B  %7.3f GB/s  %8.2f ns/hash  (%08x)\n", policyName,
+				length, stats.GigabytesPerSecond, stats.NanosecondsPerHash, stats.Checksum);
+		}
+	}
+} // namespace vex::util::quality
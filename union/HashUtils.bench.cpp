@@ -0,0 +1,85 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// FastMod against the % operator, from the repository root:
+//	g++ -std=c++20 -O2 -march=native -DNDEBUG -I. union/HashUtils.bench.cpp -o hashutils_bench
+// prints ns per reduction, best of 3, for a few table sizes. the divisor is only known at run time, as it is in
+// a prime sized table. "throughput" reduces independent hashes, "latency" feeds every result into the next input
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "HashUtils.h"
+
+using namespace vex::util;
+
+namespace
+{
+	// keeps results alive so the measured loops are not optimised out
+	volatile u64 gSink = 0;
+	// read at run time so the compiler cannot turn % into a multiply by a constant
+	volatile int gPrimeIndex = 0;
+
+	template <typename TFunc>
+	double NsPerOp(size_t ops, TFunc&& func)
+	{
+		double best = 1e30;
+		for (int run = 0; run < 3; ++run)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			func();
+			const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+			best = elapsed.count() < best ? elapsed.count() : best;
+		}
+		return best / (double)ops;
+	}
+
+	void Run(int primeIndex, const std::vector<uint32_t>& hashes)
+	{
+		gPrimeIndex = primeIndex;
+		const int index = gPrimeIndex;
+		const uint32_t prime = (uint32_t)gPrimeNumbers[index];
+		const size_t n = hashes.size();
+
+		const double modThroughput = NsPerOp(n, [&] {
+			u64 sum = 0;
+			for (uint32_t hash : hashes)
+				sum += hash % prime;
+			gSink = gSink + sum;
+		});
+		const double fastThroughput = NsPerOp(n, [&] {
+			u64 sum = 0;
+			for (uint32_t hash : hashes)
+				sum += FastMod(hash, index);
+			gSink = gSink + sum;
+		});
+		const double modLatency = NsPerOp(n, [&] {
+			uint32_t slot = 0;
+			for (uint32_t hash : hashes)
+				slot = (hash ^ slot) % prime;
+			gSink = gSink + slot;
+		});
+		const double fastLatency = NsPerOp(n, [&] {
+			uint32_t slot = 0;
+			for (uint32_t hash : hashes)
+				slot = FastMod(hash ^ slot, index);
+			gSink = gSink + slot;
+		});
+		std::printf("%9u %10.2f %10.2f %10.2f %10.2f\n", prime, modThroughput, fastThroughput, modLatency, fastLatency);
+	}
+} // namespace
+
+int main()
+{
+	std::mt19937 rng(1);
+	std::vector<uint32_t> hashes(1 << 20);
+	for (uint32_t& hash : hashes)
+		hash = rng();
+
+	std::printf("%9s %10s %10s %10s %10s   (ns/op)\n", "prime", "% thru", "fast thru", "% lat", "fast lat");
+	for (int primeIndex : {0, 12, ClosestPrimeIndex(100000), ClosestPrimeIndex(5000000), gPrimeSize - 1})
+		Run(primeIndex, hashes);
+	return 0;
+}
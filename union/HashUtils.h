@@ -3,23 +3,28 @@
  * MIT LICENSE
  * Copyright (c) 2019 Vladyslav Joss
  */
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
 
 #if INTPTR_MAX == INT64_MAX
 #define VEXCORE_x64
 #elif INTPTR_MAX == INT32_MAX
-#define ECSCORE_x32
+#define VEXCORE_x32
 #else
 #error Unknown ptr size, abort
 #endif
 
-#pragma warning(push)
-#pragma warning(disable : 26495)
-#pragma warning(disable : 26451)
-#pragma warning(disable : 28812)
-#include <VCore/Dependencies/MurmurHash3.h>
-#pragma warning(pop)
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#include "Search.h"
 
 namespace vex
 {
@@ -33,82 +38,683 @@ namespace vex
 
 		static constexpr int gPrimeSize = sizeof(gPrimeNumbers) / sizeof(int);
 
+		// smallest a[i] >= x, a[n - 1] if there is none
 		inline constexpr int FindUpperBound(const int* a, int n, int x)
 		{
-			if (x > a[n - 1])
-				return a[n - 1];
+			const size_t index = LowerBound(a, (size_t)n, x);
+			return a[index < (size_t)n ? index : n - 1];
+		}
+
+		inline constexpr int ClosestPrimeSearch(int value) { return FindUpperBound(gPrimeNumbers, gPrimeSize, value); }
+
+		// index into gPrimeNumbers of ClosestPrimeSearch(value), tables keep it to use FastMod
+		inline constexpr int ClosestPrimeIndex(int value)
+		{
+			const int prime = ClosestPrimeSearch(value);
+			int index = 0;
+			while (gPrimeNumbers[index] != prime)
+				++index;
+			return index;
+		}
+
+		// Lemire's fastmod: M = ceil(2^64 / d), a % d == mulhi64(M * a, d) for every 32 bit a.
+		// one table entry per prime in gPrimeNumbers
+		struct FastModMagic
+		{
+			static constexpr uint64_t Compute(uint32_t divisor) { return ~0ull / divisor + 1; }
 
-			int iter = 0;
-			int count = n;
-			while (iter < count)
+			static constexpr auto BuildTable()
 			{
-				int mid = (iter + count) / 2;
-				if (x > a[mid])
+				struct Table
 				{
-					iter = mid + 1;
+					uint64_t Values[gPrimeSize];
+				} table{};
+				for (int i = 0; i < gPrimeSize; ++i)
+					table.Values[i] = Compute((uint32_t)gPrimeNumbers[i]);
+				return table;
+			}
+		};
+		static constexpr auto gPrimeMagic = FastModMagic::BuildTable();
+
+		// high 64 bits of (x * d) for a 32 bit d, no 128 bit type needed
+		inline constexpr uint32_t MulHi64By32(uint64_t x, uint32_t d)
+		{
+			return (uint32_t)(((x >> 32) * d + (((x & 0xffffffffull) * d) >> 32)) >> 32);
+		}
+
+		// value % divisor via 2 multiplies, magic from FastModMagic::Compute(divisor)
+		inline constexpr uint32_t FastMod(uint32_t value, uint64_t magic, uint32_t divisor)
+		{
+			return MulHi64By32(magic * value, divisor);
+		}
+
+		// value % gPrimeNumbers[primeIndex] without a hardware divide
+		inline constexpr uint32_t FastMod(uint32_t value, int primeIndex)
+		{
+			return FastMod(value, gPrimeMagic.Values[primeIndex], (uint32_t)gPrimeNumbers[primeIndex]);
+		}
+
+		// xoshiro256**, 32 bytes of state, passes BigCrush, ~1ns per number
+		struct Xoshiro256ss
+		{
+			static inline uint64_t SplitMix64(uint64_t& state)
+			{
+				uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+				return z ^ (z >> 31);
+			}
+			static inline uint64_t Rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+			explicit Xoshiro256ss(uint64_t seed = 0) { Seed(seed); }
+
+			void Seed(uint64_t seed)
+			{
+				for (uint64_t& word : State)
+					word = SplitMix64(seed);
+			}
+
+			uint64_t Next()
+			{
+				const uint64_t result = Rotl(State[1] * 5, 7) * 9;
+				const uint64_t t = State[1] << 17;
+				State[2] ^= State[0];
+				State[3] ^= State[1];
+				State[1] ^= State[2];
+				State[0] ^= State[3];
+				State[2] ^= t;
+				State[3] = Rotl(State[3], 45);
+				return result;
+			}
+			uint32_t Next32() { return (uint32_t)(Next() >> 32); }
+
+			// uniform in [0, range), Lemire's multiply-shift with rejection - no division on the common path
+			uint32_t Bounded(uint32_t range)
+			{
+				uint64_t m = (uint64_t)Next32() * range;
+				uint32_t low = (uint32_t)m;
+				if (low < range)
+				{
+					const uint32_t threshold = (0u - range) % range;
+					while (low < threshold)
+					{
+						m = (uint64_t)Next32() * range;
+						low = (uint32_t)m;
+					}
 				}
-				else
+				return (uint32_t)(m >> 32);
+			}
+
+			// [fromInc, toExc), the offset is added unsigned so a range wider than INT_MAX does not overflow
+			int Range(int fromInc, int toExc)
+			{
+				return (int)((uint32_t)fromInc + Bounded((uint32_t)toExc - (uint32_t)fromInc));
+			}
+
+			uint64_t State[4];
+		};
+
+		namespace random_impl
+		{
+			struct RootSeed
+			{
+				std::atomic<uint64_t> Seed{std::random_device{}() | ((uint64_t)std::random_device{}() << 32)};
+				std::atomic<uint32_t> Generation{1};
+				std::atomic<uint32_t> NextThread{0};
+			};
+			inline RootSeed& Root()
+			{
+				static RootSeed root;
+				return root;
+			}
+
+			struct ThreadGenerator
+			{
+				Xoshiro256ss Generator;
+				uint32_t Generation = 0;
+			};
+
+			// per thread generator, (re)seeded from root seed + thread ordinal after SetRandomSeed()
+			inline Xoshiro256ss& LocalGenerator()
+			{
+				thread_local ThreadGenerator local;
+				RootSeed& root = Root();
+				const uint32_t generation = root.Generation.load(std::memory_order_acquire);
+				if (local.Generation != generation)
 				{
-					count = mid;
+					const uint64_t ordinal = root.NextThread.fetch_add(1, std::memory_order_relaxed);
+					local.Generator.Seed(root.Seed.load(std::memory_order_relaxed) ^ (ordinal * 0xd1b54a32d192ed03ull));
+					local.Generation = generation;
 				}
+				return local.Generator;
 			}
+		} // namespace random_impl
 
-			return a[iter];
+		// makes RandomRange reproducible: every thread reseeds on its next call, thread N (in order of
+		// first call after this) gets a stream derived from (seed, N). defaults to a random_device seed
+		inline void SetRandomSeed(uint64_t seed)
+		{
+			random_impl::RootSeed& root = random_impl::Root();
+			root.Seed.store(seed, std::memory_order_relaxed);
+			root.NextThread.store(0, std::memory_order_relaxed);
+			root.Generation.fetch_add(1, std::memory_order_release);
 		}
 
-		inline constexpr int ClosestPrimeSearch(int value) { return FindUpperBound(gPrimeNumbers, gPrimeSize, value); }
+		// thread safe, [fromInc, toExc) - exclusive, as it is more common use case
+		inline int RandomRange(int fromInc, int toExc) { return random_impl::LocalGenerator().Range(fromInc, toExc); }
 
-		inline int RandomRange(int fromInc, int toExc)
+		// fills out with values in [fromInc, toExc), generator state stays in registers for the whole batch
+		inline void FillRandomRange(std::span<int> out, int fromInc, int toExc)
 		{
-			static std::random_device rd;
-			static std::mt19937 mt(rd());
-			std::uniform_int_distribution<int> dist(fromInc,
-				toExc - 1); // exclusive, as it is more common use case
-			return dist(mt);
+			Xoshiro256ss& shared = random_impl::LocalGenerator();
+			Xoshiro256ss local = shared;
+			const uint32_t range = (uint32_t)toExc - (uint32_t)fromInc;
+			for (int& value : out)
+				value = (int)((uint32_t)fromInc + local.Bounded(range));
+			shared = local;
 		}
 
 		static const std::size_t fnv_prime = 16777619u;
 		static const std::size_t fnv_offset_basis = 2166136261u;
 
-		static inline int fnv1a(std::string const& text)
+		// 32 bit FNV-1a, usable at compile time (field names, tags, switch labels)
+		inline constexpr uint32_t fnv1a32(std::string_view text)
+		{
+			uint32_t hash = (uint32_t)fnv_offset_basis;
+			for (const char c : text)
+			{
+				hash ^= (uint8_t)c;
+				hash *= (uint32_t)fnv_prime;
+			}
+			return hash;
+		}
+
+		inline constexpr int fnv1a(std::string_view text) { return (int)fnv1a32(text); }
+		inline constexpr int fnv1a(const char* data, std::size_t size) { return (int)fnv1a32({data, size}); }
+
+		namespace murmur_impl
+		{
+			inline constexpr uint32_t Rotl(uint32_t x, int r) { return (x << r) | (x >> (32 - r)); }
+
+			// little endian load built from bytes so it also works in constant evaluation,
+			// compilers fold it into a single load at runtime
+			inline constexpr uint32_t Load32(const char* p)
+			{
+				return (uint32_t)(uint8_t)p[0] | ((uint32_t)(uint8_t)p[1] << 8) | ((uint32_t)(uint8_t)p[2] << 16) |
+					   ((uint32_t)(uint8_t)p[3] << 24);
+			}
+
+			inline constexpr uint32_t FMix32(uint32_t h)
+			{
+				h ^= h >> 16;
+				h *= 0x85ebca6bu;
+				h ^= h >> 13;
+				h *= 0xc2b2ae35u;
+				h ^= h >> 16;
+				return h;
+			}
+		} // namespace murmur_impl
+
+		// MurmurHash3_x86_32, same output as the murmur dependency
+		inline constexpr uint32_t murmur3_32(std::string_view key, uint32_t seed = 0)
+		{
+			constexpr uint32_t c1 = 0xcc9e2d51u;
+			constexpr uint32_t c2 = 0x1b873593u;
+
+			const char* data = key.data();
+			const std::size_t blocks = key.size() / 4;
+			uint32_t h1 = seed;
+			for (std::size_t i = 0; i < blocks; ++i)
+			{
+				uint32_t k1 = murmur_impl::Load32(data + i * 4);
+				k1 *= c1;
+				k1 = murmur_impl::Rotl(k1, 15);
+				k1 *= c2;
+
+				h1 ^= k1;
+				h1 = murmur_impl::Rotl(h1, 13);
+				h1 = h1 * 5 + 0xe6546b64u;
+			}
+
+			const char* tail = data + blocks * 4;
+			uint32_t k1 = 0;
+			switch (key.size() & 3)
+			{
+			case 3:
+				k1 ^= (uint32_t)(uint8_t)tail[2] << 16;
+				[[fallthrough]];
+			case 2:
+				k1 ^= (uint32_t)(uint8_t)tail[1] << 8;
+				[[fallthrough]];
+			case 1:
+				k1 ^= (uint32_t)(uint8_t)tail[0];
+				k1 *= c1;
+				k1 = murmur_impl::Rotl(k1, 15);
+				k1 *= c2;
+				h1 ^= k1;
+			}
+
+			h1 ^= (uint32_t)key.size();
+			return murmur_impl::FMix32(h1);
+		}
+
+		// 64 bit FNV-1a
+		inline constexpr uint64_t fnv1a64(std::string_view text)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (const char c : text)
+			{
+				hash ^= (uint8_t)c;
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		namespace wyhash_impl
+		{
+			// the default secret the published final4 test vectors are computed with
+			static constexpr uint64_t kP0 = 0xa0761d6478bd642full;
+			static constexpr uint64_t kP1 = 0xe7037ed1a0b428dbull;
+			static constexpr uint64_t kP2 = 0x8ebc6af09c88c6e3ull;
+			static constexpr uint64_t kP3 = 0x589965cc75374cc3ull;
+
+			// 64x64 -> 128 multiply, a = low half, b = high half
+			inline constexpr void Mum(uint64_t& a, uint64_t& b)
+			{
+#if defined(__SIZEOF_INT128__)
+				const __uint128_t r = (__uint128_t)a * b;
+				a = (uint64_t)r;
+				b = (uint64_t)(r >> 64);
+#else
+				if (!std::is_constant_evaluated())
+				{
+#if defined(_MSC_VER) && defined(_M_X64)
+					a = _umul128(a, b, &b);
+					return;
+#endif
+				}
+				const uint64_t ha = a >> 32, hb = b >> 32, la = (uint32_t)a, lb = (uint32_t)b;
+				const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+				const uint64_t t = rl + (rm0 << 32);
+				uint64_t c = t < rl;
+				const uint64_t lo = t + (rm1 << 32);
+				c += lo < t;
+				a = lo;
+				b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+			}
+
+			inline constexpr uint64_t Mix(uint64_t a, uint64_t b)
+			{
+				Mum(a, b);
+				return a ^ b;
+			}
+
+			inline constexpr uint64_t Read8(const char* p)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					uint64_t v;
+					std::memcpy(&v, p, 8);
+					return v;
+				}
+				uint64_t v = 0;
+				for (int i = 7; i >= 0; --i)
+					v = (v << 8) | (uint8_t)p[i];
+				return v;
+			}
+			inline constexpr uint64_t Read4(const char* p)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					uint32_t v;
+					std::memcpy(&v, p, 4);
+					return v;
+				}
+				return murmur_impl::Load32(p);
+			}
+			inline constexpr uint64_t Read3(const char* p, std::size_t k)
+			{
+				return ((uint64_t)(uint8_t)p[0] << 16) | ((uint64_t)(uint8_t)p[k >> 1] << 8) | (uint8_t)p[k - 1];
+			}
+
+			// first 16 bytes of input folded into (a, b), keys up to 16 bytes need nothing else
+			inline constexpr void ReadShort(const char* p, std::size_t len, uint64_t& a, uint64_t& b)
+			{
+				if (len >= 4)
+				{
+					const std::size_t shift = (len >> 3) << 2;
+					a = (Read4(p) << 32) | Read4(p + shift);
+					b = (Read4(p + len - 4) << 32) | Read4(p + len - 4 - shift);
+				}
+				else if (len > 0)
+				{
+					a = Read3(p, len);
+					b = 0;
+				}
+				else
+				{
+					a = b = 0;
+				}
+			}
+
+			inline constexpr uint64_t Finish(uint64_t a, uint64_t b, uint64_t seed, std::size_t len)
+			{
+				a ^= kP1;
+				b ^= seed;
+				Mum(a, b);
+				return Mix(a ^ kP0 ^ (uint64_t)len, b ^ kP1);
+			}
+		} // namespace wyhash_impl
+
+		// wyhash (final4), 64 bit, ~1 multiply per 8 bytes, size_t lengths
+		inline constexpr uint64_t wyhash(std::string_view key, uint64_t seed = 0)
+		{
+			using namespace wyhash_impl;
+			const char* p = key.data();
+			const std::size_t len = key.size();
+			seed ^= Mix(seed ^ kP0, kP1);
+
+			uint64_t a = 0;
+			uint64_t b = 0;
+			if (len <= 16)
+			{
+				ReadShort(p, len, a, b);
+			}
+			else
+			{
+				std::size_t i = len;
+				if (i > 48)
+				{
+					uint64_t see1 = seed;
+					uint64_t see2 = seed;
+					do
+					{
+						seed = Mix(Read8(p) ^ kP1, Read8(p + 8) ^ seed);
+						see1 = Mix(Read8(p + 16) ^ kP2, Read8(p + 24) ^ see1);
+						see2 = Mix(Read8(p + 32) ^ kP3, Read8(p + 40) ^ see2);
+						p += 48;
+						i -= 48;
+					} while (i > 48);
+					seed ^= see1 ^ see2;
+				}
+				while (i > 16)
+				{
+					seed = Mix(Read8(p) ^ kP1, Read8(p + 8) ^ seed);
+					i -= 16;
+					p += 16;
+				}
+				a = Read8(p + i - 16);
+				b = Read8(p + i - 8);
+			}
+			return Finish(a, b, seed, len);
+		}
+
+		inline constexpr uint64_t Hash64(std::string_view key, uint64_t seed = 0) { return wyhash(key, seed); }
+		inline uint64_t Hash64(const void* data, std::size_t size, uint64_t seed = 0)
+		{
+			return wyhash(std::string_view((const char*)data, size), seed);
+		}
+
+		// out[i] = Hash64(keys[i]). short keys are processed 4 at a time with their loads and multiplies
+		// interleaved, and the key bytes of the next group are prefetched
+		inline void HashBatch(std::span<const std::string_view> keys, std::span<uint64_t> out, uint64_t seed = 0)
+		{
+			using namespace wyhash_impl;
+			const std::size_t count = keys.size() < out.size() ? keys.size() : out.size();
+			const uint64_t seeded = seed ^ Mix(seed ^ kP0, kP1);
+
+			constexpr std::size_t kLanes = 4;
+			std::size_t i = 0;
+			for (; i + kLanes <= count; i += kLanes)
+			{
+#if defined(__GNUC__) || defined(__clang__)
+				if (i + 2 * kLanes <= count)
+				{
+					for (std::size_t k = 0; k < kLanes; ++k)
+						__builtin_prefetch(keys[i + kLanes + k].data());
+				}
+#endif
+				const std::string_view* group = &keys[i];
+				if (group[0].size() <= 16 && group[1].size() <= 16 && group[2].size() <= 16 && group[3].size() <= 16)
+				{
+					uint64_t a[kLanes];
+					uint64_t b[kLanes];
+					for (std::size_t k = 0; k < kLanes; ++k)
+						ReadShort(group[k].data(), group[k].size(), a[k], b[k]);
+					for (std::size_t k = 0; k < kLanes; ++k)
+						out[i + k] = Finish(a[k], b[k], seeded, group[k].size());
+				}
+				else
+				{
+					for (std::size_t k = 0; k < kLanes; ++k)
+						out[i + k] = wyhash(group[k], seed);
+				}
+			}
+			for (; i < count; ++i)
+				out[i] = wyhash(keys[i], seed);
+		}
+
+		static inline int Hash(char* c, int sz) { return (int)murmur3_32(std::string_view(c, (size_t)sz)); }
+
+		// raw byte slices (network buffers etc), hashed exactly like the same chars passed as string_view
+		using ByteSpan = std::span<const uint8_t>;
+		inline std::string_view AsChars(ByteSpan bytes)
+		{
+			return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+		}
+
+		inline uint32_t fnv1a32(ByteSpan bytes) { return fnv1a32(AsChars(bytes)); }
+		inline uint32_t murmur3_32(ByteSpan bytes, uint32_t seed = 0) { return murmur3_32(AsChars(bytes), seed); }
+		inline uint64_t wyhash(ByteSpan bytes, uint64_t seed = 0) { return wyhash(AsChars(bytes), seed); }
+
+		// incremental FNV-1a 32, Finalize() == fnv1a32(concatenation of all updates)
+		struct Fnv1aHasher
+		{
+			constexpr Fnv1aHasher& Update(std::string_view bytes)
+			{
+				for (const char c : bytes)
+				{
+					State ^= (uint8_t)c;
+					State *= (uint32_t)fnv_prime;
+				}
+				return *this;
+			}
+			Fnv1aHasher& Update(ByteSpan bytes) { return Update(AsChars(bytes)); }
+
+			constexpr uint32_t Finalize() const { return State; }
+
+			uint32_t State = (uint32_t)fnv_offset_basis;
+		};
+
+		// incremental MurmurHash3_x86_32, Finalize() == murmur3_32(concatenation of all updates, seed).
+		// up to 3 bytes of a partial block are carried between updates, nothing is allocated
+		struct Murmur3Hasher
 		{
-			std::size_t hash = fnv_offset_basis;
-			for (std::string::const_iterator it = text.begin(), end = text.end(); it != end; ++it)
+			constexpr explicit Murmur3Hasher(uint32_t seed = 0) : H1(seed) {}
+
+			constexpr Murmur3Hasher& Update(std::string_view bytes)
 			{
-				hash ^= *it;
-				hash *= fnv_prime;
+				const char* p = bytes.data();
+				std::size_t size = bytes.size();
+				Length += size;
+
+				while (TailSize != 0 && size != 0)
+				{
+					PushTail((uint8_t)*p++);
+					--size;
+				}
+				for (; size >= 4; size -= 4, p += 4)
+					MixBlock(murmur_impl::Load32(p));
+				while (size != 0)
+				{
+					PushTail((uint8_t)*p++);
+					--size;
+				}
+				return *this;
 			}
+			Murmur3Hasher& Update(ByteSpan bytes) { return Update(AsChars(bytes)); }
 
-			return (int)hash;
+			// does not modify the state, more data may follow
+			constexpr uint32_t Finalize() const
+			{
+				uint32_t h1 = H1;
+				if (TailSize != 0)
+				{
+					uint32_t k1 = Tail * kC1;
+					k1 = murmur_impl::Rotl(k1, 15);
+					k1 *= kC2;
+					h1 ^= k1;
+				}
+				h1 ^= (uint32_t)Length;
+				return murmur_impl::FMix32(h1);
+			}
+
+		private:
+			static constexpr uint32_t kC1 = 0xcc9e2d51u;
+			static constexpr uint32_t kC2 = 0x1b873593u;
+
+			constexpr void MixBlock(uint32_t k1)
+			{
+				k1 *= kC1;
+				k1 = murmur_impl::Rotl(k1, 15);
+				k1 *= kC2;
+				H1 ^= k1;
+				H1 = murmur_impl::Rotl(H1, 13);
+				H1 = H1 * 5 + 0xe6546b64u;
+			}
+			constexpr void PushTail(uint8_t b)
+			{
+				Tail |= (uint32_t)b << (TailSize * 8);
+				if (++TailSize == 4)
+				{
+					MixBlock(Tail);
+					Tail = 0;
+					TailSize = 0;
+				}
+			}
+
+			uint32_t H1;
+			uint32_t Tail = 0;
+			uint32_t TailSize = 0;
+			uint64_t Length = 0;
+		};
+
+		using Hasher = Murmur3Hasher;
+
+		// feeds one field of a composite key into a streaming hasher. strings are length prefixed,
+		// so ("ab", "c") and ("a", "bc") hash differently; scalars contribute their bytes
+		template <typename THasher, typename T>
+		constexpr THasher& HashAppend(THasher& hasher, const T& value)
+		{
+			if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			{
+				const std::string_view view = value;
+				const uint32_t size = (uint32_t)view.size();
+				const char prefix[4] = {(char)size, (char)(size >> 8), (char)(size >> 16), (char)(size >> 24)};
+				hasher.Update(std::string_view(prefix, 4));
+				hasher.Update(view);
+			}
+			else
+			{
+				static_assert(traits::IsByteValue<T> || std::is_floating_point_v<T>,
+					"HashAppend: not a scalar, append its fields instead");
+				T normalized = value;
+				if constexpr (std::is_floating_point_v<T>)
+					normalized = value == T(0) ? T(0) : value; // -0.0 == 0.0
+				hasher.Update(std::string_view(reinterpret_cast<const char*>(&normalized), sizeof(T)));
+			}
+			return hasher;
 		}
 
-		static inline int Hash(char* c, int sz) { return (int)murmur::MurmurHash3_x86_32(c, sz); }
+		// boost-style mix, for hashes of composite keys
+		inline constexpr int HashCombine(int seed, int hash)
+		{
+			uint32_t s = (uint32_t)seed;
+			s ^= (uint32_t)hash + 0x9e3779b9u + (s << 6) + (s >> 2);
+			return (int)s;
+		}
 
 		struct SHash
 		{
-			static inline int Hash(const std::string& str)
+			static inline int Hash(ByteSpan bytes) { return HashBytes(bytes.data(), bytes.size()); }
+			static constexpr int Hash(std::string_view str)
 			{
-#ifdef ECSCORE_x64
-				return (int)murmur::MurmurHash3_x86_32(str.data(), (int)str.size());
+#ifdef VEXCORE_x64
+				return (int)murmur3_32(str);
 #else
 				return fnv1a(str);
 #endif
 			}
+			static inline int HashBytes(const void* data, std::size_t size)
+			{
+				return Hash(std::string_view((const char*)data, size));
+			}
 		};
 		struct SHash_STD
 		{
-			static inline int Hash(const std::string& str) { return (int)std::hash<std::string>{}(str); }
+			static inline int Hash(ByteSpan bytes) { return HashBytes(bytes.data(), bytes.size()); }
+			static inline int Hash(std::string_view str) { return (int)std::hash<std::string_view>{}(str); }
+			static inline int HashBytes(const void* data, std::size_t size)
+			{
+				return Hash(std::string_view((const char*)data, size));
+			}
 		};
 		struct SHash_FNV1a
 		{
-			static inline int Hash(const std::string& str) { return fnv1a(str); }
+			static inline int Hash(ByteSpan bytes) { return HashBytes(bytes.data(), bytes.size()); }
+			static constexpr int Hash(std::string_view str) { return fnv1a(str); }
+			static inline int HashBytes(const void* data, std::size_t size) { return fnv1a((const char*)data, size); }
 		};
 		struct SHash_MURMUR
 		{
-			static inline int Hash(const std::string& str)
+			static inline int Hash(ByteSpan bytes) { return HashBytes(bytes.data(), bytes.size()); }
+			static constexpr int Hash(std::string_view str) { return (int)murmur3_32(str); }
+			static inline int HashBytes(const void* data, std::size_t size)
 			{
-				return (int)murmur::MurmurHash3_x86_32(str.data(), (int)str.size());
+				return (int)murmur3_32(std::string_view((const char*)data, size));
 			}
 		};
+
+		struct SHash_WY
+		{
+			static inline int Hash(ByteSpan bytes) { return HashBytes(bytes.data(), bytes.size()); }
+			static constexpr int Hash(std::string_view str) { return (int)Hash64(str); }
+			static inline int HashBytes(const void* data, std::size_t size) { return (int)Hash64(data, size); }
+			static constexpr uint64_t Hash64(std::string_view str) { return wyhash(str); }
+			static inline uint64_t Hash64(const void* data, std::size_t size) { return util::Hash64(data, size); }
+		};
+
+		// single value through a hash policy: strings by content, traits::IsByteValue values by their bytes,
+		// anything else through its std::hash so the hash follows the type's own ==
+		template <typename THashPolicy, typename T>
+		inline int HashValue(const T& value)
+		{
+			if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			{
+				const std::string_view view = value;
+				return THashPolicy::HashBytes(view.data(), view.size());
+			}
+			else if constexpr (std::is_floating_point_v<T>)
+			{
+				const T normalized = value == T(0) ? T(0) : value; // -0.0 == 0.0
+				return THashPolicy::HashBytes(&normalized, sizeof(T));
+			}
+			else if constexpr (traits::IsByteValue<T>)
+			{
+				return THashPolicy::HashBytes(&value, sizeof(T));
+			}
+			else
+			{
+				return (int)std::hash<T>{}(value);
+			}
+		}
 	} // namespace util
+
+	// compile time string hash, for switch labels: case "spawn"_hash:
+	// matches util::fnv1a32 / SHash_FNV1a at runtime
+	inline constexpr uint32_t operator"" _hash(const char* text, std::size_t size)
+	{
+		return util::fnv1a32(std::string_view(text, size));
+	}
 } // namespace vex
@@ -0,0 +1,263 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for HashUtils.h, from the repository root:
+//	g++ -std=c++20 -I. union/HashUtils.test.cpp -o hashutils_test && ./hashutils_test
+// ./hashutils_test full also sweeps FastMod over all 2^32 values of every prime
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "HashUtils.h"
+#include "Tuple.h"
+#include "TupleHash.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using namespace vex::util;
+
+namespace
+{
+	// wyhash final4 reference vectors: wyhash(kMessages[i], seed = i)
+	constexpr std::string_view kMessages[] = {"", "a", "abc", "message digest", "abcdefghijklmnopqrstuvwxyz",
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+		"12345678901234567890123456789012345678901234567890123456789012345678901234567890"};
+	constexpr uint64_t kWyhashVectors[] = {0x0409638ee2bde459ull, 0xa8412d091b5fe0a9ull, 0x32dd92e4b2915153ull,
+		0x8619124089a3a16bull, 0x7a43afb61d7f5f40ull, 0xff42329b90e50d58ull, 0xc39cab13b115aad3ull};
+
+	static_assert(wyhash(kMessages[3], 3) == kWyhashVectors[3], "wyhash must agree at compile time");
+	static_assert(fnv1a64("foobar") == 0x85944171f73967e8ull);
+
+	void CheckWyhash()
+	{
+		for (size_t i = 0; i < std::size(kMessages); ++i)
+		{
+			VEX_CHECK(wyhash(kMessages[i], i) == kWyhashVectors[i]);
+			VEX_CHECK(Hash64(kMessages[i].data(), kMessages[i].size(), i) == kWyhashVectors[i]);
+		}
+		VEX_CHECK(fnv1a64("") == 0xcbf29ce484222325ull);
+		VEX_CHECK(fnv1a64("a") == 0xaf63dc4c8601ec8cull);
+	}
+
+	// every length class (0, 1-3, 4-16, 17-48, > 48) and groups that mix short and long keys
+	void CheckHashBatch()
+	{
+		std::vector<std::string> storage;
+		for (size_t length = 0; length < 130; ++length)
+		{
+			std::string key(length, '\0');
+			for (size_t i = 0; i < length; ++i)
+				key[i] = (char)('a' + (i * 7 + length) % 26);
+			storage.push_back(key);
+		}
+		std::vector<std::string_view> keys(storage.begin(), storage.end());
+		for (uint64_t seed : {0ull, 42ull})
+		{
+			std::vector<uint64_t> hashes(keys.size());
+			HashBatch(keys, hashes, seed);
+			u32 matching = 0;
+			for (size_t i = 0; i < keys.size(); ++i)
+				matching += hashes[i] == wyhash(keys[i], seed);
+			VEX_CHECK(matching == keys.size());
+		}
+	}
+
+	struct MurmurVector
+	{
+		std::string_view Text;
+		uint32_t Seed;
+		uint32_t Hash;
+	};
+	// MurmurHash3_x86_32 reference values
+	constexpr MurmurVector kMurmurVectors[] = {
+		{"", 0, 0},
+		{"", 1, 0x514e28b7u},
+		{"", 0xffffffffu, 0x81f16f39u},
+		{"test", 0, 0xba6bd213u},
+		{"abc", 0, 0xb3dd93fau},
+		{"a", 0x9747b28cu, 0x7fa09ea6u},
+		{"aaaa", 0x9747b28cu, 0x5a97808au},
+		{"Hello, world!", 0x9747b28cu, 0x24884cbau},
+		{"The quick brown fox jumps over the lazy dog", 0x9747b28cu, 0x2fa826cdu},
+	};
+	static_assert(murmur3_32("test") == 0xba6bd213u);
+	static_assert(fnv1a32("foobar") == 0xbf9cf968u);
+
+	vex::util::ByteSpan Bytes(std::string_view text)
+	{
+		return vex::util::ByteSpan(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+	}
+
+	void CheckKnownVectors()
+	{
+		for (const MurmurVector& v : kMurmurVectors)
+		{
+			VEX_CHECK(murmur3_32(v.Text, v.Seed) == v.Hash);
+			VEX_CHECK(murmur3_32(Bytes(v.Text), v.Seed) == v.Hash);
+			VEX_CHECK(Murmur3Hasher(v.Seed).Update(v.Text).Finalize() == v.Hash);
+		}
+		// util::Hash and SHash (on 64 bit builds) are seedless murmur3
+		std::string test = "test";
+		VEX_CHECK(vex::util::Hash(test.data(), (int)test.size()) == (int)0xba6bd213u);
+#ifdef VEXCORE_x64
+		VEX_CHECK(vex::util::SHash::Hash("test") == (int)0xba6bd213u);
+#else
+		VEX_CHECK(vex::util::SHash::Hash("foobar") == (int)0xbf9cf968u);
+#endif
+		VEX_CHECK(fnv1a32("") == 0x811c9dc5u);
+		VEX_CHECK(fnv1a32("a") == 0xe40c292cu);
+		VEX_CHECK(fnv1a32(Bytes("foobar")) == 0xbf9cf968u);
+		VEX_CHECK(Fnv1aHasher().Update("foo").Update(Bytes("bar")).Finalize() == 0xbf9cf968u);
+		VEX_CHECK(wyhash(Bytes(kMessages[4]), 4) == kWyhashVectors[4]);
+	}
+
+	// incremental hashers over every split point equal the one shot hash of the whole input
+	void CheckIncremental()
+	{
+		const std::string_view text = kMessages[6];
+		u32 matching = 0;
+		u32 total = 0;
+		for (size_t first = 0; first <= text.size(); first += 3)
+		{
+			for (size_t second = first; second <= text.size(); second += 5)
+			{
+				Murmur3Hasher murmur(7);
+				murmur.Update(text.substr(0, first)).Update(text.substr(first, second - first)).Update(text.substr(second));
+				Fnv1aHasher fnv;
+				fnv.Update(text.substr(0, first)).Update(text.substr(first, second - first)).Update(text.substr(second));
+				matching += murmur.Finalize() == murmur3_32(text, 7);
+				matching += fnv.Finalize() == fnv1a32(text);
+				total += 2;
+			}
+		}
+		VEX_CHECK(matching == total);
+	}
+
+	void CheckHashAppend()
+	{
+		Hasher ab_c, a_bc;
+		HashAppend(ab_c, std::string_view("ab"));
+		HashAppend(ab_c, std::string_view("c"));
+		HashAppend(a_bc, std::string_view("a"));
+		HashAppend(a_bc, std::string_view("bc"));
+		VEX_CHECK(ab_c.Finalize() != a_bc.Finalize());
+
+		Hasher zero, negativeZero;
+		HashAppend(zero, 0.0);
+		HashAppend(negativeZero, -0.0);
+		VEX_CHECK(zero.Finalize() == negativeZero.Finalize());
+
+		Hasher members, tuple;
+		HashAppend(members, 5);
+		HashAppend(members, std::string("name"));
+		HashAppend(tuple, vex::Tuple<int, std::string>(5, "name"));
+		VEX_CHECK(members.Finalize() == tuple.Finalize());
+	}
+
+	// the full int range is wider than INT_MAX, run under -fsanitize=undefined
+	void CheckRandomRange()
+	{
+		SetRandomSeed(11);
+		bool negative = false, positive = false;
+		for (int i = 0; i < 1000; ++i)
+		{
+			const int value = RandomRange(INT_MIN, INT_MAX);
+			VEX_CHECK(value != INT_MAX);
+			negative |= value < 0;
+			positive |= value > 0;
+		}
+		VEX_CHECK(negative && positive);
+
+		std::vector<int> values(1000);
+		FillRandomRange(values, INT_MIN, INT_MAX);
+		u32 inRange = 0;
+		for (int value : values)
+			inRange += value != INT_MAX;
+		VEX_CHECK(inRange == values.size());
+
+		FillRandomRange(values, -3, 4);
+		inRange = 0;
+		for (int value : values)
+			inRange += value >= -3 && value < 4;
+		VEX_CHECK(inRange == values.size());
+		VEX_CHECK(RandomRange(5, 6) == 5);
+
+		// same seed, same stream
+		SetRandomSeed(11);
+		const int first = RandomRange(INT_MIN, INT_MAX);
+		SetRandomSeed(11);
+		VEX_CHECK(RandomRange(INT_MIN, INT_MAX) == first);
+	}
+
+	static_assert(FastMod(7199368u, gPrimeSize - 1) == 7199368u % 7199369u);
+	static_assert(FastMod(0xffffffffu, 0) == 0xffffffffu % 3u);
+
+	// FastMod against % for every prime in the table: a running remainder over [first, first + count),
+	// so whole stretches are compared without a divide per value
+	u32 CountFastModMismatches(int primeIndex, uint64_t first, uint64_t count)
+	{
+		const uint32_t prime = (uint32_t)gPrimeNumbers[primeIndex];
+		uint32_t expected = (uint32_t)(first % prime);
+		u32 mismatches = 0;
+		for (uint64_t value = first; value < first + count; ++value)
+		{
+			mismatches += FastMod((uint32_t)value, primeIndex) != expected;
+			expected = expected + 1 == prime ? 0 : expected + 1;
+		}
+		return mismatches;
+	}
+
+	// pass full = true for the exhaustive 2^32 sweep of every prime, minutes at -O2
+	void CheckFastMod(bool full)
+	{
+		std::mt19937 rng(3);
+		for (int i = 0; i < gPrimeSize; ++i)
+		{
+			const uint32_t prime = (uint32_t)gPrimeNumbers[i];
+			VEX_CHECK(gPrimeMagic.Values[i] == FastModMagic::Compute(prime));
+			if (full)
+			{
+				VEX_CHECK(CountFastModMismatches(i, 0, 1ull << 32) == 0);
+				continue;
+			}
+			// both ends of the range and around multiples of the prime spread over it
+			VEX_CHECK(CountFastModMismatches(i, 0, 1u << 20) == 0);
+			VEX_CHECK(CountFastModMismatches(i, (1ull << 32) - (1u << 20), 1u << 20) == 0);
+			u32 mismatches = 0;
+			for (uint64_t multiple = prime; multiple < (1ull << 32); multiple += (uint64_t)prime * (1 + rng() % 65521))
+			{
+				for (uint64_t value = multiple - 2; value <= multiple + 2 && value < (1ull << 32); ++value)
+					mismatches += FastMod((uint32_t)value, i) != (uint32_t)value % prime;
+			}
+			for (int sample = 0; sample < 100000; ++sample)
+			{
+				const uint32_t value = rng();
+				mismatches += FastMod(value, i) != value % prime;
+			}
+			VEX_CHECK(mismatches == 0);
+		}
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	CheckWyhash();
+	CheckHashBatch();
+	CheckKnownVectors();
+	CheckIncremental();
+	CheckHashAppend();
+	CheckRandomRange();
+	CheckFastMod(argc > 1 && std::strcmp(argv[1], "full") == 0);
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
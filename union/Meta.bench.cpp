@@ -0,0 +1,68 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// compile time benchmark for the type list queries behind Tuple and Union (Meta.h), the measured
+// thing is the compiler. from the repository root:
+//	time g++ -std=c++20 -fsyntax-only -ftime-report -fstats -I. union/Meta.bench.cpp
+// look at the "template instantiation" line of -ftime-report and the decl_specializations and
+// type_specializations counts of -fstats. best of 3 wall times are steadier than a single run.
+// only Tuple Get<I>/Get<T> and Union Has/Find are used, so the file builds on older trees for a before/after
+//	300 blocks, each a Tuple of 6 to 11 of 40 distinct types with Get<I> and Get<T> on every member,
+//	and a Union of its first 7 types with Has and Find on each
+#include <cstdio>
+#include <utility>
+
+#include "Tuple.h"
+#include "Union.h"
+
+namespace
+{
+	constexpr int kTypes = 40;
+	constexpr int kBlocks = 300;
+
+	template <int I>
+	struct S
+	{
+		int V[I % 7 + 1];
+	};
+
+	// block B takes its types at Start, Start + Stride, ... modulo kTypes. strides are coprime to
+	// kTypes so the types are distinct, and the start and stride pairs make nearly every block a new list
+	constexpr int kStrides[] = {1, 3, 7, 9, 11, 13, 17, 19};
+
+	template <int B, int J>
+	using TypeOf = S<(B * 13 + J * kStrides[B % 8]) % kTypes>;
+
+	template <int B, size_t... J>
+	int TupleBlock(std::index_sequence<J...>)
+	{
+		vex::Tuple<TypeOf<B, J>...> tuple;
+		int r = sizeof(tuple);
+		((r += &tuple.template Get<J>() == &tuple.template Get<TypeOf<B, J>>()), ...);
+		return r;
+	}
+
+	template <int B, size_t... J>
+	int UnionBlock(std::index_sequence<J...>)
+	{
+		vex::Union<TypeOf<B, J>...> value;
+		int r = sizeof(value);
+		((r += value.template Has<TypeOf<B, J>>() + (value.template Find<TypeOf<B, J>>() != nullptr)), ...);
+		return r;
+	}
+
+	template <size_t... B>
+	int AllBlocks(std::index_sequence<B...>)
+	{
+		return ((TupleBlock<B>(std::make_index_sequence<6 + B % 6>()) +
+					UnionBlock<B>(std::make_index_sequence<(6 + B % 6) < 7 ? 6 + B % 6 : 7>())) +
+			...);
+	}
+} // namespace
+
+int main()
+{
+	std::printf("%d\n", AllBlocks(std::make_index_sequence<kBlocks>()));
+	return 0;
+}
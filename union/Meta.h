@@ -0,0 +1,184 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// type list queries that do not recurse over the list: every one is a fold, a constexpr loop over
+// a bool/size array, or a single overload resolution, so a lookup in an N type pack costs O(1)
+// template instantiations instead of N nested ones, and compile depth stays flat:
+//	IndexOf<T, Ts...>, CountOf, Contains, IsUnique		values
+//	At<I, Ts...>										type
+//	Unique, Filter<Pred>, SortBySize, SortByAlignment	TypeList<...>, Apply<Template, List> unpacks one
+//	MaxSizeOf, MaxAlignOf								values
+namespace vex::meta
+{
+	template <typename... Ts>
+	struct TypeList
+	{
+		static constexpr size_t Size = sizeof...(Ts);
+	};
+
+	// IndexOf result for a type that is not in the list, also the empty Union index
+	static constexpr size_t kIndexNone = 0xff;
+
+	namespace meta_impl
+	{
+		template <size_t I, typename T>
+		struct Indexed
+		{
+			using Type = T;
+		};
+
+		// one base per element, At<I> lets overload resolution pick the base with index I
+		template <typename TSequence, typename... Ts>
+		struct Indexer;
+		template <size_t... Is, typename... Ts>
+		struct Indexer<std::index_sequence<Is...>, Ts...> : Indexed<Is, Ts>...
+		{
+		};
+
+		template <size_t I, typename T>
+		Indexed<I, T> Select(const Indexed<I, T>&); // never defined, only for decltype
+
+		template <typename T, typename... Ts>
+		constexpr size_t IndexOf()
+		{
+			constexpr bool matches[] = {std::is_same_v<T, Ts>..., false};
+			for (size_t i = 0; i < sizeof...(Ts); ++i)
+			{
+				if (matches[i])
+					return i;
+			}
+			return kIndexNone;
+		}
+
+		// positions picked out of a pack, in output order
+		template <size_t N>
+		struct Picked
+		{
+			size_t Index[N > 0 ? N : 1] = {};
+			size_t Count = 0;
+		};
+
+		template <typename... Ts>
+		constexpr auto UniquePicks()
+		{
+			constexpr size_t firsts[] = {IndexOf<Ts, Ts...>()..., 0};
+			Picked<sizeof...(Ts)> picked;
+			for (size_t i = 0; i < sizeof...(Ts); ++i)
+			{
+				if (firsts[i] == i)
+					picked.Index[picked.Count++] = i;
+			}
+			return picked;
+		}
+
+		template <template <typename> class TPred, typename... Ts>
+		constexpr auto FilterPicks()
+		{
+			constexpr bool keep[] = {bool(TPred<Ts>::value)..., false};
+			Picked<sizeof...(Ts)> picked;
+			for (size_t i = 0; i < sizeof...(Ts); ++i)
+			{
+				if (keep[i])
+					picked.Index[picked.Count++] = i;
+			}
+			return picked;
+		}
+
+		// stable insertion sort of the positions, largest key first
+		template <size_t N>
+		constexpr Picked<N> SortPicks(const size_t (&keys)[N + 1])
+		{
+			Picked<N> picked;
+			for (size_t i = 0; i < N; ++i)
+			{
+				size_t j = i;
+				for (; j > 0 && keys[picked.Index[j - 1]] < keys[i]; --j)
+					picked.Index[j] = picked.Index[j - 1];
+				picked.Index[j] = i;
+			}
+			picked.Count = N;
+			return picked;
+		}
+
+		template <auto Picks, typename TSequence, typename... Ts>
+		struct Pick;
+
+		template <template <typename...> class TTemplate, typename TList>
+		struct Apply;
+		template <template <typename...> class TTemplate, typename... Ts>
+		struct Apply<TTemplate, TypeList<Ts...>>
+		{
+			using Type = TTemplate<Ts...>;
+		};
+	} // namespace meta_impl
+
+	template <typename T, typename... Ts>
+	inline constexpr bool Contains = (std::is_same_v<T, Ts> || ...);
+
+	template <typename T, typename... Ts>
+	inline constexpr size_t CountOf = (size_t(0) + ... + size_t(std::is_same_v<T, Ts>));
+
+	// position of the first T in Ts, kIndexNone when there is none
+	template <typename T, typename... Ts>
+	inline constexpr size_t IndexOf = meta_impl::IndexOf<T, Ts...>();
+
+	template <size_t I, typename... Ts>
+	using At = typename decltype(meta_impl::Select<I>(
+		std::declval<const meta_impl::Indexer<std::index_sequence_for<Ts...>, Ts...>&>()))::Type;
+
+	template <typename... Ts>
+	inline constexpr bool IsUnique = ((CountOf<Ts, Ts...> == 1) && ...);
+
+	template <typename... Ts>
+	inline constexpr size_t MaxSizeOf = [] {
+		size_t max = 0;
+		((max = sizeof(Ts) > max ? sizeof(Ts) : max), ...);
+		return max;
+	}();
+
+	template <typename... Ts>
+	inline constexpr size_t MaxAlignOf = [] {
+		size_t max = 0;
+		((max = alignof(Ts) > max ? alignof(Ts) : max), ...);
+		return max;
+	}();
+
+	namespace meta_impl
+	{
+		template <auto Picks, size_t... Is, typename... Ts>
+		struct Pick<Picks, std::index_sequence<Is...>, Ts...>
+		{
+			using Type = TypeList<At<Picks.Index[Is], Ts...>...>;
+		};
+
+		template <auto Picks, typename... Ts>
+		using PickT = typename Pick<Picks, std::make_index_sequence<Picks.Count>, Ts...>::Type;
+	} // namespace meta_impl
+
+	// first occurrence of every type, in order
+	template <typename... Ts>
+	using Unique = meta_impl::PickT<meta_impl::UniquePicks<Ts...>(), Ts...>;
+
+	// the types for which TPred<T>::value holds, in order: Filter<std::is_trivial, Ts...>
+	template <template <typename> class TPred, typename... Ts>
+	using Filter = meta_impl::PickT<meta_impl::FilterPicks<TPred, Ts...>(), Ts...>;
+
+	// largest first, equal sizes keep their order
+	template <typename... Ts>
+	using SortBySize = meta_impl::PickT<meta_impl::SortPicks<sizeof...(Ts)>({sizeof(Ts)..., 0}), Ts...>;
+
+	// most aligned first, equal alignments keep their order. members laid out in this order need no padding
+	// between them
+	template <typename... Ts>
+	using SortByAlignment = meta_impl::PickT<meta_impl::SortPicks<sizeof...(Ts)>({alignof(Ts)..., 0}), Ts...>;
+
+	// TTemplate<Ts...> for TypeList<Ts...>: Apply<Union, Unique<A, B, A>> is Union<A, B>
+	template <template <typename...> class TTemplate, typename TList>
+	using Apply = typename meta_impl::Apply<TTemplate, TList>::Type;
+} // namespace vex::meta
@@ -0,0 +1,243 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <array>
+#include <string_view>
+
+#include "HashUtils.h"
+#include "Tuple.h"
+
+namespace vex
+{
+	// string literal usable as template argument: Get<"pos">()
+	template <size_t N>
+	struct FixedString
+	{
+		char Data[N]{};
+
+		constexpr FixedString(const char (&text)[N])
+		{
+			for (size_t i = 0; i < N; ++i)
+				Data[i] = text[i];
+		}
+		constexpr std::string_view View() const { return std::string_view(Data, N - 1); }
+	};
+
+	template <FixedString Name, typename T>
+	struct Field
+	{
+		using Type = T;
+		static constexpr std::string_view kName = Name.View();
+		static constexpr u32 kHash = util::fnv1a32(kName);
+	};
+
+	// Tuple whose members are also addressable by name:
+	//	using Particle = NamedTuple<Field<"pos", Vec3>, Field<"ttl", float>>;
+	//	p.Get<"ttl">() -= dt;
+	// names are hashed at compile time, lookups by name at runtime go through a hash-sorted table
+	template <typename... Fields>
+	struct NamedTuple : public Tuple<typename Fields::Type...>
+	{
+		using Base = Tuple<typename Fields::Type...>;
+		using Base::Base;
+		using Base::Get;
+		using Base::get;
+
+		static constexpr auto FieldCount = sizeof...(Fields);
+
+		struct FieldInfo
+		{
+			u32 Hash;
+			u32 Length;
+			u32 Index;
+		};
+
+	private:
+		static constexpr u32 kHashes[] = {Fields::kHash...};
+		static constexpr std::string_view kNames[] = {Fields::kName...};
+
+		// compile time lookup, the hash only rules fields out, a match is confirmed on the whole name
+		static constexpr int FindIndex(std::string_view name)
+		{
+			const u32 hash = util::fnv1a32(name);
+			for (u32 i = 0; i < FieldCount; ++i)
+			{
+				if (kHashes[i] == hash && kNames[i] == name)
+					return (int)i;
+			}
+			return -1;
+		}
+
+		static constexpr bool HasUniqueNames()
+		{
+			for (u32 i = 0; i < FieldCount; ++i)
+			{
+				for (u32 j = i + 1; j < FieldCount; ++j)
+				{
+					if (kNames[i] == kNames[j])
+						return false;
+				}
+			}
+			return true;
+		}
+		static_assert(HasUniqueNames(), "duplicate field names in NamedTuple");
+
+		static constexpr bool HasUniqueHashes()
+		{
+			for (u32 i = 0; i < FieldCount; ++i)
+			{
+				for (u32 j = i + 1; j < FieldCount; ++j)
+				{
+					if (kHashes[i] == kHashes[j])
+						return false;
+				}
+			}
+			return true;
+		}
+		// the runtime table is searched by hash, so two names must not share one
+		static_assert(HasUniqueHashes(), "fnv1a collision between NamedTuple field names, rename one of them");
+
+		static constexpr auto BuildFieldTable()
+		{
+			std::array<FieldInfo, FieldCount> table = {FieldInfo{Fields::kHash, (u32)Fields::kName.size(), 0}...};
+			for (u32 i = 0; i < FieldCount; ++i)
+				table[i].Index = i;
+			// insertion sort by hash, runtime lookup is a binary search over hashes
+			for (u32 i = 1; i < FieldCount; ++i)
+			{
+				for (u32 j = i; j > 0 && table[j].Hash < table[j - 1].Hash; --j)
+				{
+					const FieldInfo tmp = table[j];
+					table[j] = table[j - 1];
+					table[j - 1] = tmp;
+				}
+			}
+			return table;
+		}
+
+		// the members of a Tuple are its ValueHolder bases, each holding just the member, laid out in order
+		// with nothing in between, so the offsets follow from sizes and alignments. references are stored as pointers
+		template <typename T>
+		using StoredT = std::conditional_t<std::is_reference_v<T>, void*, T>;
+
+		static constexpr std::array<u32, FieldCount + 1> BuildOffsets()
+		{
+			constexpr size_t sizes[] = {sizeof(StoredT<typename Fields::Type>)..., 0};
+			constexpr size_t aligns[] = {alignof(StoredT<typename Fields::Type>)..., 1};
+			std::array<u32, FieldCount + 1> offsets = {};
+			size_t end = 0;
+			for (u32 i = 0; i < FieldCount; ++i)
+			{
+				offsets[i] = (u32)((end + aligns[i] - 1) / aligns[i] * aligns[i]);
+				end = offsets[i] + sizes[i];
+			}
+			offsets[FieldCount] = (u32)end; // end of the last member
+			return offsets;
+		}
+		static constexpr std::array<u32, FieldCount + 1> kLayout = BuildOffsets();
+		static_assert(FieldCount == 0 ||
+						  (kLayout[FieldCount] + alignof(Base) - 1) / alignof(Base) * alignof(Base) == sizeof(Base),
+					  "Tuple layout is not the one NamedTuple computes member offsets for");
+
+		// position in kFieldTable, -1 if there is no such field
+		static constexpr int FindSlot(std::string_view name)
+		{
+			const u32 hash = util::fnv1a32(name);
+			u32 first = 0;
+			u32 count = FieldCount;
+			while (count > 0)
+			{
+				const u32 step = count / 2;
+				if (kFieldTable[first + step].Hash < hash)
+				{
+					first += step + 1;
+					count -= step + 1;
+				}
+				else
+				{
+					count = step;
+				}
+			}
+			if (first < FieldCount && kFieldTable[first].Hash == hash && kFieldTable[first].Length == name.size())
+				return (int)first;
+			return -1;
+		}
+
+	public:
+		static constexpr std::array<FieldInfo, FieldCount> kFieldTable = BuildFieldTable();
+
+		// byte offset of each member from the start of the tuple, by member index
+		static constexpr std::array<u32, FieldCount> kFieldOffsets = [] {
+			std::array<u32, FieldCount> offsets = {};
+			for (u32 i = 0; i < FieldCount; ++i)
+				offsets[i] = kLayout[i];
+			return offsets;
+		}();
+
+		template <FixedString Name>
+		static constexpr int IndexOf()
+		{
+			constexpr int index = FindIndex(Name.View());
+			static_assert(index >= 0, "NamedTuple has no field with this name");
+			return index;
+		}
+
+		template <FixedString Name>
+		static constexpr bool HasField()
+		{
+			return FindIndex(Name.View()) >= 0;
+		}
+
+		template <FixedString Name>
+		constexpr auto& Get()
+		{
+			return Base::template Get<IndexOf<Name>()>();
+		}
+		template <FixedString Name>
+		constexpr const auto& Get() const
+		{
+			return Base::template Get<IndexOf<Name>()>();
+		}
+
+		// runtime name lookup, one hash + binary search, no string compares
+		static constexpr const FieldInfo* FindField(std::string_view name)
+		{
+			const int slot = FindSlot(name);
+			return slot >= 0 ? &kFieldTable[slot] : nullptr;
+		}
+
+		static constexpr int IndexOf(std::string_view name)
+		{
+			const int slot = FindSlot(name);
+			return slot >= 0 ? (int)kFieldTable[slot].Index : -1;
+		}
+
+		// untyped access for reflection/serialization, nullptr if there is no such field
+		void* FieldPtr(std::string_view name)
+		{
+			const FieldInfo* info = FindField(name);
+			return info ? reinterpret_cast<byte*>(this) + kFieldOffsets[info->Index] : nullptr;
+		}
+		const void* FieldPtr(std::string_view name) const
+		{
+			const FieldInfo* info = FindField(name);
+			return info ? reinterpret_cast<const byte*>(this) + kFieldOffsets[info->Index] : nullptr;
+		}
+	};
+} // namespace vex
+
+namespace std
+{
+	template <typename... Fields>
+	struct tuple_size<vex::NamedTuple<Fields...>> : std::integral_constant<std::size_t, sizeof...(Fields)>
+	{
+	};
+
+	template <std::size_t N, typename... Fields>
+	struct tuple_element<N, vex::NamedTuple<Fields...>>
+	{
+		using type = typename vex::GetTypeByIndex<N, typename Fields::Type...>::type;
+	};
+} // namespace std
@@ -0,0 +1,76 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for NamedTuple.h, from the repository root:
+//	g++ -std=c++20 -I. union/NamedTuple.test.cpp -o namedtuple_test && ./namedtuple_test
+#include <cstdio>
+#include <string>
+
+#include "NamedTuple.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+struct Vec3
+{
+	float X, Y, Z;
+};
+struct Padded
+{
+	double D;
+	char C;
+};
+
+using Particle = vex::NamedTuple<vex::Field<"pos", Vec3>, vex::Field<"ttl", float>, vex::Field<"name", std::string>,
+								 vex::Field<"id", int>>;
+using Mixed = vex::NamedTuple<vex::Field<"c", char>, vex::Field<"padded", Padded>, vex::Field<"s", short>,
+							  vex::Field<"ref", int&>>;
+
+// name lookups, compile time and runtime ones alike
+static_assert(Particle::IndexOf<"ttl">() == 1);
+static_assert(Particle::IndexOf("pos") == 0 && Particle::IndexOf("id") == 3);
+static_assert(Particle::IndexOf("nope") == -1 && Particle::IndexOf("") == -1);
+static_assert(Particle::FindField("name")->Index == 2);
+static_assert(Particle::kFieldOffsets[0] == 0 && Particle::kFieldOffsets[1] == sizeof(Vec3));
+static_assert(Mixed::kFieldOffsets[1] == alignof(Padded) && Mixed::kFieldOffsets[2] == alignof(Padded) + sizeof(Padded));
+
+// "liquid" and "costarring" share an fnv1a hash, only the name tells them apart
+using Colliding = vex::NamedTuple<vex::Field<"liquid", int>, vex::Field<"zinke", float>>;
+static_assert(vex::util::fnv1a32("liquid") == vex::util::fnv1a32("costarring"));
+static_assert(vex::util::fnv1a32("zinke") == vex::util::fnv1a32("altarage"));
+static_assert(Colliding::HasField<"liquid">() && Colliding::HasField<"zinke">());
+static_assert(!Colliding::HasField<"costarring">() && !Colliding::HasField<"altarage">() && !Colliding::HasField<"liqui">());
+static_assert(Colliding::IndexOf<"zinke">() == 1);
+static_assert(Colliding::IndexOf("costarring") == -1 && Colliding::IndexOf("altarage") == -1);
+
+int main()
+{
+	Particle particle(Vec3{1, 2, 3}, 5.f, "spark", 7);
+	particle.Get<"ttl">() -= 1.f;
+	VEX_CHECK(particle.Get<1>() == 4.f);
+	VEX_CHECK(particle.Get<"name">() == "spark");
+
+	*static_cast<int*>(particle.FieldPtr("id")) = 9;
+	VEX_CHECK(particle.Get<"id">() == 9);
+	VEX_CHECK(particle.FieldPtr("missing") == nullptr);
+
+	// the computed offsets against the real member addresses
+	VEX_CHECK(particle.FieldPtr("pos") == &particle.Get<"pos">());
+	VEX_CHECK(particle.FieldPtr("name") == &particle.Get<"name">());
+	int target = 0;
+	Mixed mixed('a', Padded{1.0, 'b'}, (short)3, target);
+	VEX_CHECK(mixed.FieldPtr("padded") == &mixed.Get<"padded">());
+	VEX_CHECK(mixed.FieldPtr("s") == &mixed.Get<"s">());
+	mixed.Get<"ref">() = 5;
+	VEX_CHECK(target == 5);
+
+	auto& [pos, ttl, name, id] = particle;
+	VEX_CHECK(pos.Z == 3.f && ttl == 4.f && name == "spark" && id == 9);
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -0,0 +1,189 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <atomic>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "CoreTemplates.h"
+#include "RangeAdaptors.h"
+#include "ThreadPool.h"
+#include "Tuple.h"
+
+// 1 makes every Parallel* call run serially on the calling thread, in index order
+#ifndef VEX_PARALLEL_SERIAL
+#define VEX_PARALLEL_SERIAL 0
+#endif
+
+namespace vex
+{
+	namespace parallel_impl
+	{
+		inline std::atomic<bool> gForceSerial = VEX_PARALLEL_SERIAL != 0;
+
+		// ~4 pieces per thread, enough slack for stealing to even out uneven iterations
+		inline int AutoGrain(int count, const ThreadPool& pool)
+		{
+			const int pieces = 4 * (int)(pool.WorkerCount() + 1);
+			return count / pieces > 1 ? count / pieces : 1;
+		}
+
+		// halves the range until it is at most grain long, the upper halves become stealable jobs
+		template <typename TFunc>
+		void ForSplit(JobGroup& group, int begin, int end, int grain, TFunc& func)
+		{
+			while (end - begin > grain)
+			{
+				const int mid = begin + (end - begin) / 2;
+				group.Run([&group, &func, mid, end, grain] { ForSplit(group, mid, end, grain, func); });
+				end = mid;
+			}
+			for (int i = begin; i < end; ++i)
+				func(i);
+		}
+
+		// the split tree depends only on the range and grain, and partial results are combined in tree
+		// order, so serial (pool == nullptr) and parallel runs produce the same value
+		template <typename T, typename TFunc, typename TCombine>
+		T ReduceSplit(ThreadPool* pool, int begin, int end, int grain, const T& identity, TFunc& func,
+			TCombine& combine)
+		{
+			if (end - begin <= grain)
+			{
+				T acc = identity;
+				for (int i = begin; i < end; ++i)
+					acc = func(std::move(acc), i);
+				return acc;
+			}
+
+			const int mid = begin + (end - begin) / 2;
+			if (!pool)
+			{
+				T left = ReduceSplit(pool, begin, mid, grain, identity, func, combine);
+				return combine(std::move(left), ReduceSplit(pool, mid, end, grain, identity, func, combine));
+			}
+
+			std::optional<T> right;
+			JobGroup group(*pool);
+			group.Run([&right, &identity, &func, &combine, pool, mid, end, grain] {
+				right.emplace(ReduceSplit(pool, mid, end, grain, identity, func, combine));
+			});
+			T left = ReduceSplit(pool, begin, mid, grain, identity, func, combine);
+			group.Wait();
+			return combine(std::move(left), std::move(*right));
+		}
+
+		template <typename TTuple, typename TFunc, int First, int... Rest>
+		void ParallelForEachImpl(JobGroup& group, TTuple& tuple, TFunc& func, std::integer_sequence<int, First, Rest...>)
+		{
+			(..., group.Run([&tuple, &func] { func(tuple.template Get<Rest>()); }));
+			func(tuple.template Get<First>()); // first member runs on the calling thread
+			group.Wait();
+		}
+	} // namespace parallel_impl
+
+	// debugging switch: while set, ParallelFor/ParallelReduce/ParallelForEach run serially
+	// on the calling thread in index order. ParallelReduce results do not change
+	inline void SetParallelSerial(bool serial) { parallel_impl::gForceSerial.store(serial, std::memory_order_relaxed); }
+	inline bool IsParallelSerial() { return parallel_impl::gForceSerial.load(std::memory_order_relaxed); }
+
+	// func(member) for each member as an independent job, returns once all of them are done.
+	// members must not alias each other, func must be safe to call concurrently
+	template <typename TTuple, typename TFunc>
+	void ParallelForEach(TTuple& tuple, TFunc&& func, ThreadPool& pool = ThreadPool::Global())
+	{
+		static_assert(tuple_impl::IsTupleV<TTuple>, "ParallelForEach expects vex::Tuple");
+		if constexpr (std::decay_t<TTuple>::MemberCount > 0)
+		{
+			if (IsParallelSerial())
+			{
+				ForEach(tuple, func);
+				return;
+			}
+			JobGroup group(pool);
+			parallel_impl::ParallelForEachImpl(group, tuple, func, tuple_impl::SequenceOf<TTuple>{});
+		}
+	}
+
+	// func(i) for every i in [range.Start, range.End), split recursively into pieces of at most grain
+	// indices. safe to nest: a waiting caller runs queued pieces instead of blocking
+	template <typename TFunc>
+	void ParallelFor(Range range, int grain, TFunc&& func, ThreadPool& pool = ThreadPool::Global())
+	{
+		if (range.End <= range.Start)
+			return;
+		if (IsParallelSerial() || pool.WorkerCount() == 0)
+		{
+			for (int i = range.Start; i < range.End; ++i)
+				func(i);
+			return;
+		}
+		JobGroup group(pool);
+		parallel_impl::ForSplit(group, range.Start, range.End, grain > 0 ? grain : 1, func);
+		group.Wait();
+	}
+
+	template <typename TFunc>
+	void ParallelFor(Range range, TFunc&& func, ThreadPool& pool = ThreadPool::Global())
+	{
+		ParallelFor(range, parallel_impl::AutoGrain(range.End - range.Start, pool), func, pool);
+	}
+
+	// CRange visits the same indices in either direction, order is unspecified when parallel
+	template <int Start, int End, typename TFunc>
+	void ParallelFor(CRange<Start, End>, TFunc&& func, ThreadPool& pool = ThreadPool::Global())
+	{
+		if constexpr (Start <= End)
+			ParallelFor(Range(Start, End), func, pool);
+		else
+			ParallelFor(Range(End + 1, Start + 1), func, pool);
+	}
+
+	// sink(x) for every x of range | pipe, range is cut into pieces of grain indices run as separate
+	// jobs. pipe must be elementwise (Map, Filter and compositions of them), sink safe to call concurrently
+	template <typename TPipe, typename TSink>
+		requires adaptors_impl::IsAdaptor<TPipe>
+	void ParallelFor(Range range, int grain, const TPipe& pipe, TSink&& sink, ThreadPool& pool = ThreadPool::Global())
+	{
+		static_assert(TPipe::kElementwise, "Take, Enumerate, Zip and Chunk depend on position and cannot be split");
+		const ChunkView<Range> pieces{range, grain > 0 ? grain : 1};
+		ParallelFor(
+			Range(pieces.Count()), 1,
+			[&](int piece) {
+				ForEachElement(ranges_impl::TileOf(range, pieces.Size, piece) | pipe, sink);
+			},
+			pool);
+	}
+
+	template <typename TPipe, typename TSink>
+		requires adaptors_impl::IsAdaptor<TPipe>
+	void ParallelFor(Range range, const TPipe& pipe, TSink&& sink, ThreadPool& pool = ThreadPool::Global())
+	{
+		ParallelFor(range, parallel_impl::AutoGrain(range.End - range.Start, pool), pipe, sink, pool);
+	}
+
+	// combine(... func(func(identity, i0), i1) ..., ...) over [range.Start, range.End).
+	// identity must be neutral for combine. the result is identical for a given grain whatever
+	// the thread count or the serial switch, the default grain depends on the pool size
+	template <typename T, typename TFunc, typename TCombine>
+	T ParallelReduce(Range range, int grain, T identity, TFunc&& func, TCombine&& combine,
+		ThreadPool& pool = ThreadPool::Global())
+		requires std::is_invocable_v<TCombine&, T, T>
+	{
+		if (range.End <= range.Start)
+			return identity;
+		ThreadPool* parallelPool = IsParallelSerial() || pool.WorkerCount() == 0 ? nullptr : &pool;
+		return parallel_impl::ReduceSplit(
+			parallelPool, range.Start, range.End, grain > 0 ? grain : 1, identity, func, combine);
+	}
+
+	template <typename T, typename TFunc, typename TCombine>
+	T ParallelReduce(Range range, T identity, TFunc&& func, TCombine&& combine, ThreadPool& pool = ThreadPool::Global())
+	{
+		return ParallelReduce(
+			range, parallel_impl::AutoGrain(range.End - range.Start, pool), std::move(identity), func, combine, pool);
+	}
+} // namespace vex
@@ -0,0 +1,127 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for Parallel.h, from the repository root:
+//	g++ -std=c++20 -pthread -I. union/Parallel.test.cpp -o parallel_test && ./parallel_test
+// the pools are sized explicitly, so the splits are exercised on a single core machine too
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Parallel.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+namespace
+{
+	// every index of [0, count) visited exactly once
+	void CheckFor(vex::ThreadPool& pool)
+	{
+		constexpr int kCount = 10000;
+		for (int grain : {0, 1, 7, 100, kCount, 2 * kCount})
+		{
+			std::unique_ptr<std::atomic<u32>[]> visits(new std::atomic<u32>[kCount]());
+			vex::ParallelFor(vex::Range(kCount), grain, [&](int i) { visits[i].fetch_add(1); }, pool);
+			u32 once = 0;
+			for (int i = 0; i < kCount; ++i)
+				once += visits[i].load() == 1;
+			VEX_CHECK(once == kCount);
+		}
+
+		std::atomic<int> sum = 0;
+		vex::ParallelFor(vex::Range(-50, 50), [&](int i) { sum += i; }, pool);
+		VEX_CHECK(sum == -50);
+		vex::ParallelFor(vex::Range(5, 5), [&](int) { sum += 1000; }, pool);
+		vex::ParallelFor(vex::Range(5, 2), [&](int) { sum += 1000; }, pool);
+		VEX_CHECK(sum == -50);
+
+		// reversed compile time ranges visit the same indices
+		std::atomic<int> reversed = 0;
+		vex::ParallelFor(vex::CRange<9, -1>{}, [&](int i) { reversed += i; }, pool);
+		VEX_CHECK(reversed == 45);
+
+		// nested loops wait by running queued pieces, they do not block the workers
+		std::atomic<int> cells = 0;
+		vex::ParallelFor(vex::Range(32), 1, [&](int) {
+			vex::ParallelFor(vex::Range(32), 4, [&](int) { cells.fetch_add(1); }, pool);
+		}, pool);
+		VEX_CHECK(cells == 32 * 32);
+	}
+
+	void CheckPipe(vex::ThreadPool& pool)
+	{
+		std::atomic<long long> sum = 0;
+		const auto pipe =
+			vex::Map([](int i) { return (long long)i * i; }) | vex::Filter([](long long x) { return x % 2 == 0; });
+		vex::ParallelFor(vex::Range(1000), 37, pipe, [&](long long x) { sum += x; }, pool);
+		long long expected = 0;
+		for (long long i = 0; i < 1000; i += 2)
+			expected += i * i;
+		VEX_CHECK(sum == expected);
+	}
+
+	void CheckReduce(vex::ThreadPool& pool, vex::ThreadPool& single)
+	{
+		const auto add = [](long long acc, int i) { return acc + i; };
+		const auto plus = [](long long a, long long b) { return a + b; };
+		VEX_CHECK(vex::ParallelReduce(vex::Range(100000), 0ll, add, plus, pool) == 4999950000ll);
+		VEX_CHECK(vex::ParallelReduce(vex::Range(3, 3), 7ll, add, plus, pool) == 7);
+
+		// float sums depend on association, equal grains give bit identical results on any pool
+		const auto addf = [](float acc, int i) { return acc + 1.f / (float)(i + 1); };
+		const auto plusf = [](float a, float b) { return a + b; };
+		const float parallel = vex::ParallelReduce(vex::Range(100000), 64, 0.f, addf, plusf, pool);
+		VEX_CHECK(parallel == vex::ParallelReduce(vex::Range(100000), 64, 0.f, addf, plusf, single));
+		vex::SetParallelSerial(true);
+		VEX_CHECK(parallel == vex::ParallelReduce(vex::Range(100000), 64, 0.f, addf, plusf, pool));
+		vex::SetParallelSerial(false);
+
+		// combine is not commutative: pieces are joined in index order
+		const std::string digits = vex::ParallelReduce(
+			vex::Range(100), 3, std::string(),
+			[](std::string acc, int i) { return acc + (char)('0' + i % 10); },
+			[](std::string a, const std::string& b) { return a + b; }, pool);
+		std::string expected;
+		for (int i = 0; i < 100; ++i)
+			expected += (char)('0' + i % 10);
+		VEX_CHECK(digits == expected);
+	}
+
+	void CheckSerialAndForEach(vex::ThreadPool& pool)
+	{
+		vex::SetParallelSerial(true);
+		VEX_CHECK(vex::IsParallelSerial());
+		std::vector<int> order;
+		vex::ParallelFor(vex::Range(10), 1, [&](int i) { order.push_back(i); }, pool);
+		vex::SetParallelSerial(false);
+		bool inOrder = order.size() == 10;
+		for (int i = 0; inOrder && i < 10; ++i)
+			inOrder = order[i] == i;
+		VEX_CHECK(inOrder);
+
+		vex::Tuple<std::vector<int>, std::vector<int>, std::vector<int>> columns;
+		vex::ParallelForEach(columns, [](std::vector<int>& column) { column.assign(1000, 1); }, pool);
+		VEX_CHECK(columns.Get<0>().size() == 1000 && columns.Get<1>().size() == 1000 && columns.Get<2>()[999] == 1);
+	}
+} // namespace
+
+int main()
+{
+	vex::ThreadPool pool(3);
+	vex::ThreadPool single(0);
+	CheckFor(pool);
+	CheckFor(single);
+	CheckPipe(pool);
+	CheckReduce(pool, single);
+	CheckSerialAndForEach(pool);
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -0,0 +1,171 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <string_view>
+
+#include "CoreTemplates.h"
+#include "HashUtils.h"
+
+namespace vex::util
+{
+	// collision free lookup table over a fixed set of strings, generated at compile time:
+	//	static constexpr auto kCommands = MakePerfectHash("spawn", "kill", "list");
+	//	switch (kCommands.Find(name)) { case 0: ...; case -1: unknown }
+	// lookup is one murmur3 hash, a displacement read, an integer mix and one string compare.
+	template <std::size_t N>
+	struct PerfectHash
+	{
+		static_assert(N > 0, "PerfectHash needs at least one key");
+
+		static constexpr u32 kSlotCount = [] {
+			u32 count = 1;
+			while (count < N)
+				count <<= 1;
+			return count;
+		}();
+		static constexpr u32 kBucketCount = kSlotCount;
+
+		std::array<std::string_view, N> Keys{};
+		std::array<u32, kBucketCount> Displacement{};
+		std::array<i32, kSlotCount> SlotToKey{};
+		u32 Seed = 0;
+
+		static constexpr u32 Slot(u32 hash, u32 displacement)
+		{
+			return murmur_impl::FMix32(hash ^ displacement) & (kSlotCount - 1);
+		}
+
+		// index of key in the generating set, -1 if it is not there
+		constexpr int Find(std::string_view key) const
+		{
+			const u32 hash = murmur3_32(key, Seed);
+			const i32 index = SlotToKey[Slot(hash, Displacement[hash & (kBucketCount - 1)])];
+			return (index >= 0 && Keys[index] == key) ? index : -1;
+		}
+
+		constexpr bool Contains(std::string_view key) const { return Find(key) >= 0; }
+		static constexpr std::size_t Size() { return N; }
+	};
+
+	namespace perfect_hash_impl
+	{
+		static constexpr u32 kMaxSeeds = 64;
+		static constexpr u32 kMaxDisplacement = 1u << 16;
+
+		// not constexpr on purpose: reaching it during constant evaluation is a compile error
+		inline void BuildFailed(const char*) { std::abort(); }
+
+		// hash and displace: keys are bucketed by hash, buckets are placed largest first,
+		// each bucket gets the first displacement that moves all of its keys to free slots.
+		// everything is sorted or bucketed once, so a few thousand keys stay well inside the
+		// compiler's constexpr operation limit
+		template <std::size_t N>
+		constexpr bool TryBuild(PerfectHash<N>& table, u32 seed)
+		{
+			using TTable = PerfectHash<N>;
+			constexpr u32 kBuckets = TTable::kBucketCount;
+			constexpr u32 kMask = kBuckets - 1;
+
+			std::array<u32, N> hashes{};
+			std::array<u32, N> byHash{};
+			for (u32 i = 0; i < N; ++i)
+			{
+				hashes[i] = murmur3_32(table.Keys[i], seed);
+				byHash[i] = i;
+			}
+			std::sort(byHash.begin(), byHash.end(), [&](u32 lhs, u32 rhs) { return hashes[lhs] < hashes[rhs]; });
+			for (u32 i = 1; i < N; ++i)
+			{
+				const u32 lhs = byHash[i - 1];
+				const u32 rhs = byHash[i];
+				if (hashes[lhs] != hashes[rhs])
+					continue;
+				if (table.Keys[lhs] == table.Keys[rhs])
+					BuildFailed("MakePerfectHash: duplicate key");
+				return false; // no displacement can split a full collision
+			}
+
+			// keys of bucket b are BucketKeys[BucketStart[b]] .. BucketKeys[BucketStart[b + 1] - 1]
+			std::array<u32, kBuckets + 1> bucketStart{};
+			for (u32 i = 0; i < N; ++i)
+				++bucketStart[(hashes[i] & kMask) + 1];
+			for (u32 b = 0; b < kBuckets; ++b)
+				bucketStart[b + 1] += bucketStart[b];
+			std::array<u32, N> bucketKeys{};
+			std::array<u32, kBuckets> filled{};
+			for (u32 i = 0; i < N; ++i)
+			{
+				const u32 bucket = hashes[i] & kMask;
+				bucketKeys[bucketStart[bucket] + filled[bucket]++] = i;
+			}
+
+			std::array<u32, kBuckets> order{};
+			for (u32 b = 0; b < kBuckets; ++b)
+				order[b] = b;
+			std::sort(order.begin(), order.end(), [&](u32 lhs, u32 rhs) {
+				return filled[lhs] != filled[rhs] ? filled[lhs] > filled[rhs] : lhs < rhs;
+			});
+
+			table.SlotToKey.fill(-1);
+			table.Displacement.fill(0);
+			std::array<u32, N> slots{};
+			for (const u32 bucket : order)
+			{
+				const u32 first = bucketStart[bucket];
+				const u32 size = filled[bucket];
+				if (size == 0)
+					break;
+
+				bool placed = false;
+				for (u32 d = 0; d < kMaxDisplacement && !placed; ++d)
+				{
+					bool fits = true;
+					for (u32 k = 0; k < size && fits; ++k)
+					{
+						const u32 slot = TTable::Slot(hashes[bucketKeys[first + k]], d);
+						fits = table.SlotToKey[slot] < 0;
+						for (u32 j = 0; j < k && fits; ++j)
+							fits = slots[j] != slot;
+						slots[k] = slot;
+					}
+					if (!fits)
+						continue;
+
+					for (u32 k = 0; k < size; ++k)
+						table.SlotToKey[slots[k]] = (i32)bucketKeys[first + k];
+					table.Displacement[bucket] = d;
+					placed = true;
+				}
+				if (!placed)
+					return false;
+			}
+			table.Seed = seed;
+			return true;
+		}
+	} // namespace perfect_hash_impl
+
+	template <std::size_t N>
+	constexpr PerfectHash<N> MakePerfectHash(const std::array<std::string_view, N>& keys)
+	{
+		PerfectHash<N> table;
+		table.Keys = keys;
+		for (u32 seed = 0; seed < perfect_hash_impl::kMaxSeeds; ++seed)
+		{
+			if (perfect_hash_impl::TryBuild(table, seed))
+				return table;
+		}
+		perfect_hash_impl::BuildFailed("MakePerfectHash: no collision free table found");
+		return table;
+	}
+
+	template <typename... TKeys>
+	constexpr auto MakePerfectHash(const TKeys&... keys)
+	{
+		return MakePerfectHash(std::array<std::string_view, sizeof...(TKeys)>{std::string_view(keys)...});
+	}
+} // namespace vex::util
@@ -0,0 +1,153 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for PerfectHash.h and the constexpr string hashes it is built on, from the repository root:
+//	g++ -std=c++20 -I. union/PerfectHash.test.cpp -o perfecthash_test && ./perfecthash_test
+// the large table is built at compile time under the default -fconstexpr-ops-limit
+#include <array>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+#include "PerfectHash.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using vex::util::fnv1a32;
+using vex::util::MakePerfectHash;
+using vex::util::murmur3_32;
+using namespace vex; // _hash
+
+namespace
+{
+	// published FNV-1a 32 and MurmurHash3_x86_32 vectors, checked during compilation
+	static_assert(fnv1a32("") == 0x811c9dc5u && fnv1a32("a") == 0xe40c292cu && fnv1a32("foobar") == 0xbf9cf968u);
+	static_assert(murmur3_32("") == 0 && murmur3_32("", 1) == 0x514e28b7u && murmur3_32("", 0xffffffffu) == 0x81f16f39u);
+	static_assert(murmur3_32("test") == 0xba6bd213u && murmur3_32("abc") == 0xb3dd93fau);
+	static_assert(murmur3_32("a", 0x9747b28cu) == 0x7fa09ea6u && murmur3_32("aaaa", 0x9747b28cu) == 0x5a97808au);
+	static_assert(murmur3_32("Hello, world!", 0x9747b28cu) == 0x24884cbau);
+	static_assert(murmur3_32("The quick brown fox jumps over the lazy dog", 0x9747b28cu) == 0x2fa826cdu);
+	static_assert("foobar"_hash == 0xbf9cf968u && ""_hash == 0x811c9dc5u);
+
+	// the same functions over strings only known at run time
+	void CheckRuntimeHashes()
+	{
+		constexpr std::string_view kTexts[] = {"", "a", "abc", "aaaa", "tail", "tail1", "tail12", "tail123", "spawn"};
+		constexpr auto kExpected = [&] {
+			std::array<u32, 2 * std::size(kTexts)> hashes{};
+			for (size_t i = 0; i < std::size(kTexts); ++i)
+			{
+				hashes[2 * i] = fnv1a32(kTexts[i]);
+				hashes[2 * i + 1] = murmur3_32(kTexts[i], 0x9747b28cu);
+			}
+			return hashes;
+		}();
+		u32 matching = 0;
+		for (size_t i = 0; i < std::size(kTexts); ++i)
+		{
+			const std::string text(kTexts[i]); // a heap copy, nothing here is a constant expression
+			matching += fnv1a32(text) == kExpected[2 * i];
+			matching += murmur3_32(text, 0x9747b28cu) == kExpected[2 * i + 1];
+			matching += vex::util::SHash_FNV1a::Hash(text) == (int)kExpected[2 * i];
+		}
+		VEX_CHECK(matching == 3 * std::size(kTexts));
+
+		// _hash labels dispatch on a runtime string
+		auto dispatch = [](std::string_view name) {
+			switch (fnv1a32(name))
+			{
+			case "spawn"_hash: return 1;
+			case "kill"_hash: return 2;
+			default: return 0;
+			}
+		};
+		VEX_CHECK(dispatch(std::string("spawn")) == 1 && dispatch(std::string("kill")) == 2 && dispatch("list") == 0);
+	}
+
+	// "cmd_0000" .. "cmd_3999", a dispatch table sized like a real one
+	constexpr u32 kNameCount = 4000;
+	constexpr u32 kNameLength = 8;
+
+	struct NameChars
+	{
+		char Chars[kNameCount * kNameLength];
+	};
+
+	constexpr NameChars kNameChars = [] {
+		NameChars names{};
+		for (u32 i = 0; i < kNameCount; ++i)
+		{
+			char* name = names.Chars + i * kNameLength;
+			name[0] = 'c';
+			name[1] = 'm';
+			name[2] = 'd';
+			name[3] = '_';
+			for (u32 digit = 0, value = i; digit < 4; ++digit, value /= 10)
+				name[7 - digit] = (char)('0' + value % 10);
+		}
+		return names;
+	}();
+
+	constexpr std::string_view NameOf(u32 index)
+	{
+		return std::string_view(kNameChars.Chars + index * kNameLength, kNameLength);
+	}
+
+	constexpr auto kNames = [] {
+		std::array<std::string_view, kNameCount> names{};
+		for (u32 i = 0; i < kNameCount; ++i)
+			names[i] = NameOf(i);
+		return names;
+	}();
+
+	constexpr auto kLarge = MakePerfectHash(kNames);
+	static_assert(kLarge.Find("cmd_0000") == 0 && kLarge.Find("cmd_3999") == 3999 && kLarge.Find("cmd_4000") == -1);
+
+	constexpr auto kCommands = MakePerfectHash("spawn", "kill", "list", "", "spawn_all");
+	static_assert(kCommands.Find("kill") == 1 && kCommands.Find("") == 3 && !kCommands.Contains("spaw"));
+	static_assert(MakePerfectHash("only").Find("only") == 0 && MakePerfectHash("only").Find("other") == -1);
+
+	void CheckLookups()
+	{
+		u32 found = 0;
+		for (u32 i = 0; i < kNameCount; ++i)
+			found += kLarge.Find(NameOf(i)) == (int)i;
+		VEX_CHECK(found == kNameCount);
+
+		// misses: other numbers, other prefixes, prefixes of keys, and longer strings
+		u32 missed = 0, misses = 0;
+		for (u32 i = kNameCount; i < 3 * kNameCount; ++i, ++misses)
+		{
+			const std::string name = "cmd_" + std::to_string(i);
+			missed += kLarge.Find(name) == -1;
+		}
+		for (u32 i = 0; i < kNameCount; i += 7, misses += 3)
+		{
+			const std::string name(NameOf(i));
+			missed += kLarge.Find("CMD_" + name.substr(4)) == -1;
+			missed += kLarge.Find(name.substr(0, 7)) == -1;
+			missed += kLarge.Find(name + "x") == -1;
+		}
+		VEX_CHECK(missed == misses);
+
+		const char* commands[] = {"spawn", "kill", "list", "", "spawn_all"};
+		for (int i = 0; i < 5; ++i)
+			VEX_CHECK(kCommands.Find(std::string(commands[i])) == i);
+		VEX_CHECK(kCommands.Find("Spawn") == -1 && kCommands.Find("spawn_") == -1);
+		VEX_CHECK(kCommands.Size() == 5);
+	}
+} // namespace
+
+int main()
+{
+	CheckRuntimeHashes();
+	CheckLookups();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// Pool against malloc/free under allocation churn, from the repository root:
+//	g++ -std=c++20 -O2 -march=native -DNDEBUG -pthread -I. union/Pool.bench.cpp -o pool_bench
+// prints ns per allocate + free pair, best of 3:
+//	burst		allocate 1000 blocks, free them in reverse, repeat
+//	random		10000 live blocks, each step frees a random one and allocates its replacement
+//	threads		the random pattern on 4 threads at once, ns per pair per thread
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Pool.h"
+
+namespace
+{
+	// keeps results alive so the measured loops are not optimised out
+	volatile u64 gSink = 0;
+
+	template <typename TFunc>
+	double NsPerOp(size_t ops, TFunc&& func)
+	{
+		double best = 1e30;
+		for (int run = 0; run < 3; ++run)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			func();
+			const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+			best = elapsed.count() < best ? elapsed.count() : best;
+		}
+		return best / (double)ops;
+	}
+
+	template <size_t Size>
+	struct PoolAlloc
+	{
+		static void* Allocate() { return vex::memory::Pool<Size>::Allocate(); }
+		static void Free(void* ptr) { vex::memory::Pool<Size>::Free(ptr); }
+	};
+
+	template <size_t Size>
+	struct MallocAlloc
+	{
+		static void* Allocate() { return std::malloc(Size); }
+		static void Free(void* ptr) { std::free(ptr); }
+	};
+
+	// blocks are touched on allocation, as real objects would be
+	template <size_t Size, typename TAlloc>
+	void* Touch()
+	{
+		void* ptr = TAlloc::Allocate();
+		*static_cast<u64*>(ptr) = Size;
+		return ptr;
+	}
+
+	template <size_t Size, typename TAlloc>
+	double Burst()
+	{
+		constexpr int kBlocks = 1000;
+		constexpr int kRounds = 1000;
+		std::vector<void*> blocks(kBlocks);
+		return NsPerOp((size_t)kBlocks * kRounds, [&] {
+			for (int round = 0; round < kRounds; ++round)
+			{
+				for (void*& block : blocks)
+					block = Touch<Size, TAlloc>();
+				for (int i = kBlocks; i-- > 0;)
+					TAlloc::Free(blocks[i]);
+			}
+		});
+	}
+
+	template <size_t Size, typename TAlloc>
+	void RandomChurn(size_t steps, u64 seed)
+	{
+		std::vector<void*> live(10000);
+		for (void*& block : live)
+			block = Touch<Size, TAlloc>();
+		std::mt19937 rng((u32)seed);
+		u64 sum = 0;
+		for (size_t step = 0; step < steps; ++step)
+		{
+			void*& victim = live[rng() % live.size()];
+			sum += *static_cast<u64*>(victim);
+			TAlloc::Free(victim);
+			victim = Touch<Size, TAlloc>();
+		}
+		for (void* block : live)
+			TAlloc::Free(block);
+		gSink = gSink + sum;
+	}
+
+	template <size_t Size, typename TAlloc>
+	double Random()
+	{
+		constexpr size_t kSteps = 1000000;
+		return NsPerOp(kSteps, [] { RandomChurn<Size, TAlloc>(kSteps, 1); });
+	}
+
+	template <size_t Size, typename TAlloc>
+	double Threads()
+	{
+		constexpr size_t kSteps = 500000;
+		return NsPerOp(kSteps, [] {
+			std::vector<std::thread> threads;
+			for (int t = 0; t < 4; ++t)
+				threads.emplace_back([t] { RandomChurn<Size, TAlloc>(kSteps, t + 1); });
+			for (std::thread& thread : threads)
+				thread.join();
+		});
+	}
+
+	template <size_t Size>
+	void Run()
+	{
+		std::printf("%6zu B %-8s %8.2f %8.2f %8.2f\n", Size, "Pool", Burst<Size, PoolAlloc<Size>>(),
+			Random<Size, PoolAlloc<Size>>(), Threads<Size, PoolAlloc<Size>>());
+		std::printf("%6zu B %-8s %8.2f %8.2f %8.2f\n", Size, "malloc", Burst<Size, MallocAlloc<Size>>(),
+			Random<Size, MallocAlloc<Size>>(), Threads<Size, MallocAlloc<Size>>());
+	}
+} // namespace
+
+int main()
+{
+	std::printf("%8s %-8s %8s %8s %8s   (ns per allocate + free)\n", "size", "", "burst", "random", "threads");
+	Run<16>();
+	Run<64>();
+	Run<256>();
+	Run<4096>();
+	return 0;
+}
@@ -0,0 +1,183 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "CoreTemplates.h"
+
+namespace vex::memory
+{
+	// fixed size block allocator, one per (Size, Align) class shared by the whole process.
+	// free blocks form an intrusive list threaded through the blocks themselves. every thread keeps a
+	// small cache, refilled from and spilled to a global list kBatch blocks at a time, so Allocate and
+	// Free only take the global lock once per kBatch calls. blocks are carved from slabs aligned to 2 MB so
+	// the OS can back them with huge pages: 2 MB, or the multiple of 2 MB that holds a whole batch of large
+	// blocks. slabs are never returned to the system.
+	template <size_t Size, size_t Align = alignof(std::max_align_t)>
+	struct Pool
+	{
+		static_assert(Align > 0 && (Align & (Align - 1)) == 0, "Pool alignment must be a power of two");
+
+		static constexpr size_t kAlign = Align > alignof(void*) ? Align : alignof(void*);
+		static constexpr size_t kBlockSize = ((Size > sizeof(void*) ? Size : sizeof(void*)) + kAlign - 1) & ~(kAlign - 1);
+		static constexpr u32 kBatch = 64;
+		static constexpr size_t kSlabAlign = 2 * 1024 * 1024;
+		static constexpr size_t kSlabSize = (kBlockSize * kBatch + kSlabAlign - 1) / kSlabAlign * kSlabAlign;
+
+		static_assert(kSlabSize / kBlockSize >= kBatch, "a slab must hold a whole refill batch");
+
+		static void* Allocate()
+		{
+			Cache& cache = tCache;
+			if (!cache.Head)
+				Refill(cache);
+			FreeNode* node = cache.Head;
+			cache.Head = node->Next;
+			--cache.Count;
+			return node;
+		}
+
+		static void Free(void* ptr)
+		{
+			if (!ptr)
+				return;
+			Cache& cache = tCache;
+			FreeNode* node = static_cast<FreeNode*>(ptr);
+			node->Next = cache.Head;
+			cache.Head = node;
+			if (++cache.Count >= 2 * kBatch)
+				Spill(cache, kBatch);
+		}
+
+		static size_t SlabCount()
+		{
+			std::lock_guard<std::mutex> guard(Shared().Lock);
+			return Shared().Slabs.size();
+		}
+
+	private:
+		struct FreeNode
+		{
+			FreeNode* Next;
+		};
+
+		struct Chain
+		{
+			FreeNode* Head;
+			u32 Count;
+		};
+
+		struct Global
+		{
+			std::mutex Lock;
+			std::vector<Chain> Chains;
+			std::vector<void*> Slabs;
+			byte* SlabCursor = nullptr;
+			byte* SlabEnd = nullptr;
+		};
+
+		// returns its blocks to the global list when its thread exits
+		struct Cache
+		{
+			~Cache()
+			{
+				if (Head)
+					Spill(*this, Count);
+			}
+
+			FreeNode* Head = nullptr;
+			u32 Count = 0;
+		};
+
+		// never destroyed: thread caches may spill into it during static destruction
+		static Global& Shared()
+		{
+			static Global* global = new Global;
+			return *global;
+		}
+
+		static void Refill(Cache& cache)
+		{
+			Global& global = Shared();
+			std::lock_guard<std::mutex> guard(global.Lock);
+			if (!global.Chains.empty())
+			{
+				const Chain chain = global.Chains.back();
+				global.Chains.pop_back();
+				cache.Head = chain.Head;
+				cache.Count = chain.Count;
+				return;
+			}
+
+			if ((size_t)(global.SlabEnd - global.SlabCursor) < kBlockSize * kBatch)
+			{
+				byte* slab = static_cast<byte*>(::operator new(kSlabSize, std::align_val_t{kSlabAlign}));
+				global.Slabs.push_back(slab);
+				global.SlabCursor = slab;
+				global.SlabEnd = slab + kSlabSize / kBlockSize * kBlockSize;
+			}
+			// link the new blocks in address order, so a fresh cache hands them out sequentially
+			FreeNode* head = nullptr;
+			for (u32 i = kBatch; i-- > 0;)
+			{
+				FreeNode* node = reinterpret_cast<FreeNode*>(global.SlabCursor + i * kBlockSize);
+				node->Next = head;
+				head = node;
+			}
+			global.SlabCursor += kBlockSize * kBatch;
+			cache.Head = head;
+			cache.Count = kBatch;
+		}
+
+		// moves count blocks from the front of the cache to the global list
+		static void Spill(Cache& cache, u32 count)
+		{
+			FreeNode* head = cache.Head;
+			FreeNode* tail = head;
+			for (u32 i = 1; i < count; ++i)
+				tail = tail->Next;
+			cache.Head = tail->Next;
+			cache.Count -= count;
+			tail->Next = nullptr;
+
+			Global& global = Shared();
+			std::lock_guard<std::mutex> guard(global.Lock);
+			global.Chains.push_back(Chain{head, count});
+		}
+
+		static inline thread_local Cache tCache;
+	};
+
+	// Pool sized for the largest and most aligned of Types, e.g. boxed Union payloads or message nodes
+	// carrying any of several types. every TypedPool with the same size and alignment shares one pool
+	template <typename... Types>
+	struct TypedPool
+	{
+		using PoolT = Pool<MaxSizeOf<Types...>(), MaxAlignOf<Types...>()>;
+
+		static void* Allocate() { return PoolT::Allocate(); }
+		static void Free(void* ptr) { PoolT::Free(ptr); }
+
+		template <typename T, typename... TArgs>
+		static T* New(TArgs&&... args)
+		{
+			static_assert(sizeof(T) <= PoolT::kBlockSize && alignof(T) <= PoolT::kAlign, "type does not fit the pool");
+			return new (PoolT::Allocate()) T(std::forward<TArgs>(args)...);
+		}
+
+		template <typename T>
+		static void Delete(T* object)
+		{
+			if (!object)
+				return;
+			object->~T();
+			PoolT::Free(object);
+		}
+	};
+} // namespace vex::memory
@@ -0,0 +1,133 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for Pool.h, from the repository root:
+//	g++ -std=c++20 -pthread -fsanitize=address -I. union/Pool.test.cpp -o pool_test && ./pool_test
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Pool.h"
+#include "Union.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using vex::memory::Pool;
+using vex::memory::TypedPool;
+
+// over 32 KB a batch no longer fits in 2 MB, the slab grows to hold one
+static_assert(Pool<40000>::kSlabSize == 4 * 1024 * 1024);
+static_assert(Pool<24>::kSlabSize == 2 * 1024 * 1024 && Pool<24>::kBlockSize == 32);
+static_assert(Pool<1, 64>::kBlockSize == 64 && Pool<1>::kBlockSize == alignof(std::max_align_t));
+
+namespace
+{
+	// every block is distinct, aligned, and writable over its whole size
+	template <size_t Size, size_t Align = alignof(std::max_align_t)>
+	void CheckBlocks(int count)
+	{
+		using PoolT = Pool<Size, Align>;
+		std::vector<void*> blocks;
+		u32 aligned = 0;
+		for (int i = 0; i < count; ++i)
+		{
+			void* block = PoolT::Allocate();
+			std::memset(block, i, Size); // ASan reports a block past the end of its slab here
+			aligned += ((uintptr_t)block & (PoolT::kAlign - 1)) == 0;
+			blocks.push_back(block);
+		}
+		VEX_CHECK(aligned == (u32)count);
+		VEX_CHECK(std::set<void*>(blocks.begin(), blocks.end()).size() == blocks.size());
+
+		// freed blocks are handed out again before new slabs are taken
+		const size_t slabs = PoolT::SlabCount();
+		for (void* block : blocks)
+			PoolT::Free(block);
+		for (void*& block : blocks)
+			block = PoolT::Allocate();
+		VEX_CHECK(PoolT::SlabCount() == slabs);
+		for (void* block : blocks)
+			PoolT::Free(block);
+	}
+
+	// blocks allocated on one thread and freed on another go back through the global list
+	void CheckThreads()
+	{
+		using PoolT = Pool<48>;
+		std::vector<void*> blocks(10000);
+		std::thread producer([&] {
+			for (void*& block : blocks)
+				block = PoolT::Allocate();
+		});
+		producer.join();
+		std::thread consumer([&] {
+			for (void* block : blocks)
+				PoolT::Free(block);
+		});
+		consumer.join();
+
+		const size_t slabs = PoolT::SlabCount();
+		std::vector<std::thread> churn;
+		for (int t = 0; t < 4; ++t)
+		{
+			churn.emplace_back([] {
+				std::vector<void*> local;
+				for (int round = 0; round < 50; ++round)
+				{
+					for (int i = 0; i < 200; ++i)
+						local.push_back(PoolT::Allocate());
+					for (void* block : local)
+						PoolT::Free(block);
+					local.clear();
+				}
+			});
+		}
+		for (std::thread& thread : churn)
+			thread.join();
+		VEX_CHECK(PoolT::SlabCount() == slabs);
+	}
+
+	struct Big
+	{
+		char Bytes[50000];
+	};
+
+	void CheckTypedPool()
+	{
+		using Value = vex::Union<int, std::string, Big>;
+		using Values = TypedPool<Value>;
+		std::vector<Value*> values;
+		for (int i = 0; i < 100; ++i)
+			values.push_back(Values::New<Value>(std::string(40, (char)('a' + i % 26))));
+		u32 intact = 0;
+		for (int i = 0; i < 100; ++i)
+			intact += values[i]->Has<std::string>() && values[i]->GetUnchecked<std::string>()[39] == (char)('a' + i % 26);
+		VEX_CHECK(intact == 100);
+		for (Value* value : values)
+			Values::Delete(value);
+		Values::Delete<Value>(nullptr);
+	}
+} // namespace
+
+int main()
+{
+	CheckBlocks<8>(1000);
+	CheckBlocks<24>(100000);
+	CheckBlocks<100, 64>(1000);
+	CheckBlocks<40000>(200);
+	CheckBlocks<3 * 1024 * 1024>(3);
+	CheckThreads();
+	CheckTypedPool();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
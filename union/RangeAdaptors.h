@@ -0,0 +1,529 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "CoreTemplates.h"
+#include "Ranges.h"
+
+// lazy adaptors on the sentinel model: every view is a struct holding its source by value and
+// every iterator a couple of fields compared against impl::__vexSentinel, nothing allocates and
+// nothing is type erased, so a pipeline inlines into the loop one would write by hand:
+//	for (float v : values | Map([](float x) { return x * x; }) | Filter([](float x) { return x > 1; }))
+//	for (auto [i, v] : values | Enumerate() | Take(10))
+//	for (Range chunk : Range(n) | Chunk(4096))
+// containers are referenced (they must outlive the view), spans, Range, CRange, StridedRange and views are copied.
+// adaptors compose on their own, auto pipe = Map(f) | Filter(p). ForEachElement and ForEachBatch run a
+// pipeline into a sink, ParallelFor (Parallel.h) runs a Map/Filter pipeline over a Range in parallel
+namespace vex
+{
+	namespace adaptors_impl
+	{
+		// what operator| dispatches on
+		struct AdaptorTag
+		{
+		};
+
+		template <typename T>
+		constexpr bool IsAdaptor = std::is_base_of_v<AdaptorTag, std::decay_t<T>>;
+
+		template <typename T>
+		concept SentinelRange = requires(const T& range) {
+			{ range.end() } -> std::same_as<impl::__vexSentinel>;
+		};
+
+		// the four comparisons every iterator here needs, TSelf provides IsDone()
+		template <typename TSelf>
+		struct SentinelIterator
+		{
+			friend bool operator==(const TSelf& lhs, impl::__vexSentinel) { return lhs.IsDone(); }
+			friend bool operator==(impl::__vexSentinel lhs, const TSelf& rhs) { return rhs == lhs; }
+			friend bool operator!=(const TSelf& lhs, impl::__vexSentinel rhs) { return !(lhs == rhs); }
+			friend bool operator!=(impl::__vexSentinel lhs, const TSelf& rhs) { return !(lhs == rhs); }
+		};
+
+		// begin/end pair of a container, seen through the sentinel model
+		template <typename TIterator>
+		struct IteratorView
+		{
+			struct Iterator : SentinelIterator<Iterator>
+			{
+				Iterator(TIterator current, TIterator end) : Current(current), End(end) {}
+
+				bool IsDone() const { return Current == End; }
+				decltype(auto) operator*() const { return *Current; }
+				Iterator& operator++()
+				{
+					++Current;
+					return *this;
+				}
+
+				TIterator Current;
+				TIterator End;
+			};
+
+			Iterator begin() const noexcept { return Iterator(Begin, End); }
+			impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+
+			TIterator Begin;
+			TIterator End;
+		};
+
+		// the rest of a sentinel range from a given iterator on, what Chunk hands out
+		template <typename TIterator>
+		struct TailView
+		{
+			TIterator begin() const noexcept { return Begin; }
+			impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+
+			TIterator Begin;
+		};
+
+		template <typename TSource>
+		auto AsView(TSource&& source)
+		{
+			if constexpr (SentinelRange<std::remove_cvref_t<TSource>>)
+			{
+				return std::remove_cvref_t<TSource>(std::forward<TSource>(source));
+			}
+			else
+			{
+				static_assert(std::is_lvalue_reference_v<TSource> || std::ranges::enable_borrowed_range<std::remove_cvref_t<TSource>>,
+					"a container must outlive its views, pass an lvalue");
+				using std::begin;
+				using std::end;
+				return IteratorView<decltype(begin(source))>{begin(source), end(source)};
+			}
+		}
+
+		template <typename TSource>
+		using ViewOf = decltype(AsView(std::declval<TSource>()));
+
+		template <typename TView>
+		using IteratorOf = decltype(std::declval<const TView&>().begin());
+
+		// push iteration: views that can, run func inside their source's loop (Map and Filter
+		// become a call and an if in the body), the rest are walked through their iterators
+		template <typename TView, typename TFunc>
+		void Each(const TView& view, TFunc&& func)
+		{
+			if constexpr (requires { view.Each(func); })
+			{
+				view.Each(func);
+			}
+			else
+			{
+				for (auto&& value : view)
+					func(std::forward<decltype(value)>(value));
+			}
+		}
+	} // namespace adaptors_impl
+
+	template <typename T>
+	struct Enumerated
+	{
+		int Index;
+		T Value;
+	};
+
+	template <typename TFirst, typename TSecond>
+	struct Zipped
+	{
+		TFirst First;
+		TSecond Second;
+	};
+
+	template <typename TBase, typename TFunc>
+	struct MapView
+	{
+		struct Iterator : adaptors_impl::SentinelIterator<Iterator>
+		{
+			Iterator(adaptors_impl::IteratorOf<TBase> current, const MapView* owner) : Current(current), Owner(owner) {}
+
+			bool IsDone() const { return Current == impl::__vexSentinel{}; }
+			decltype(auto) operator*() const { return Owner->Func(*Current); }
+			Iterator& operator++()
+			{
+				++Current;
+				return *this;
+			}
+
+			adaptors_impl::IteratorOf<TBase> Current;
+			const MapView* Owner;
+		};
+
+		Iterator begin() const noexcept { return Iterator(Base.begin(), this); }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+
+		template <typename TSink>
+		void Each(TSink& sink) const
+		{
+			adaptors_impl::Each(Base, [&](auto&& value) { sink(Func(std::forward<decltype(value)>(value))); });
+		}
+
+		TBase Base;
+		TFunc Func;
+	};
+
+	template <typename TBase, typename TPredicate>
+	struct FilterView
+	{
+		struct Iterator : adaptors_impl::SentinelIterator<Iterator>
+		{
+			Iterator(adaptors_impl::IteratorOf<TBase> current, const FilterView* owner) : Current(current), Owner(owner)
+			{
+				SkipRejected();
+			}
+
+			bool IsDone() const { return Current == impl::__vexSentinel{}; }
+			decltype(auto) operator*() const { return *Current; }
+			Iterator& operator++()
+			{
+				++Current;
+				SkipRejected();
+				return *this;
+			}
+
+			void SkipRejected()
+			{
+				while (!IsDone() && !Owner->Predicate(*Current))
+					++Current;
+			}
+
+			adaptors_impl::IteratorOf<TBase> Current;
+			const FilterView* Owner;
+		};
+
+		Iterator begin() const noexcept { return Iterator(Base.begin(), this); }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+
+		template <typename TSink>
+		void Each(TSink& sink) const
+		{
+			adaptors_impl::Each(Base, [&](auto&& value) {
+				if (Predicate(value))
+					sink(std::forward<decltype(value)>(value));
+			});
+		}
+
+		TBase Base;
+		TPredicate Predicate;
+	};
+
+	template <typename TBase>
+	struct TakeView
+	{
+		struct Iterator : adaptors_impl::SentinelIterator<Iterator>
+		{
+			Iterator(adaptors_impl::IteratorOf<TBase> current, int left) : Current(current), Left(left) {}
+
+			bool IsDone() const { return Left <= 0 || Current == impl::__vexSentinel{}; }
+			decltype(auto) operator*() const { return *Current; }
+			Iterator& operator++()
+			{
+				++Current;
+				--Left;
+				return *this;
+			}
+
+			adaptors_impl::IteratorOf<TBase> Current;
+			int Left;
+		};
+
+		Iterator begin() const noexcept { return Iterator(Base.begin(), Count); }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+
+		TBase Base;
+		int Count;
+	};
+
+	template <typename TBase>
+	struct EnumerateView
+	{
+		struct Iterator : adaptors_impl::SentinelIterator<Iterator>
+		{
+			Iterator(adaptors_impl::IteratorOf<TBase> current) : Current(current) {}
+
+			bool IsDone() const { return Current == impl::__vexSentinel{}; }
+			auto operator*() const { return Enumerated<decltype(*Current)>{Index, *Current}; }
+			Iterator& operator++()
+			{
+				++Current;
+				++Index;
+				return *this;
+			}
+
+			adaptors_impl::IteratorOf<TBase> Current;
+			int Index = 0;
+		};
+
+		Iterator begin() const noexcept { return Iterator(Base.begin()); }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+
+		TBase Base;
+	};
+
+	// stops with the shorter of the two
+	template <typename TFirst, typename TSecond>
+	struct ZipView
+	{
+		struct Iterator : adaptors_impl::SentinelIterator<Iterator>
+		{
+			Iterator(adaptors_impl::IteratorOf<TFirst> first, adaptors_impl::IteratorOf<TSecond> second)
+				: First(first), Second(second)
+			{
+			}
+
+			bool IsDone() const { return First == impl::__vexSentinel{} || Second == impl::__vexSentinel{}; }
+			auto operator*() const { return Zipped<decltype(*First), decltype(*Second)>{*First, *Second}; }
+			Iterator& operator++()
+			{
+				++First;
+				++Second;
+				return *this;
+			}
+
+			adaptors_impl::IteratorOf<TFirst> First;
+			adaptors_impl::IteratorOf<TSecond> Second;
+		};
+
+		Iterator begin() const noexcept { return Iterator(First.begin(), Second.begin()); }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+
+		TFirst First;
+		TSecond Second;
+	};
+
+	// consecutive pieces of at most Size elements, each a Take view over the rest of the source.
+	// a Range is chunked into Ranges, which is what ParallelFor and the Tiled loops consume
+	template <typename TBase>
+	struct ChunkView
+	{
+		using TChunk = TakeView<adaptors_impl::TailView<adaptors_impl::IteratorOf<TBase>>>;
+
+		struct Iterator : adaptors_impl::SentinelIterator<Iterator>
+		{
+			Iterator(adaptors_impl::IteratorOf<TBase> current, int size) : Current(current), Size(size) {}
+
+			bool IsDone() const { return Current == impl::__vexSentinel{}; }
+			TChunk operator*() const { return TChunk{{Current}, Size}; }
+			Iterator& operator++()
+			{
+				for (int i = 0; i < Size && !IsDone(); ++i)
+					++Current;
+				return *this;
+			}
+
+			adaptors_impl::IteratorOf<TBase> Current;
+			int Size;
+		};
+
+		Iterator begin() const noexcept { return Iterator(Base.begin(), Size); }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+
+		TBase Base;
+		int Size;
+	};
+
+	template <>
+	struct ChunkView<Range>
+	{
+		struct Iterator : adaptors_impl::SentinelIterator<Iterator>
+		{
+			Iterator(int current, int end, int size) : Current(current), End(end), Size(size) {}
+
+			bool IsDone() const { return Current >= End; }
+			Range operator*() const { return Range(Current, End - Current > Size ? Current + Size : End); }
+			Iterator& operator++()
+			{
+				Current += Size;
+				return *this;
+			}
+
+			int Current;
+			int End;
+			int Size;
+		};
+
+		Iterator begin() const noexcept { return Iterator(Base.Start, Base.End, Size); }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+		int Count() const noexcept { return ranges_impl::TileCount(Base, Size); }
+
+		Range Base;
+		int Size;
+	};
+
+	namespace adaptors_impl
+	{
+		// Elementwise adaptors treat every element on its own, so a pipeline made only of them gives the
+		// same elements whether it runs over a range or over each piece of it
+		template <typename TFunc>
+		struct MapAdaptor : AdaptorTag
+		{
+			static constexpr bool kElementwise = true;
+			template <typename TView>
+			auto Apply(TView&& view) const
+			{
+				return MapView<std::remove_cvref_t<TView>, TFunc>{std::forward<TView>(view), Func};
+			}
+			TFunc Func;
+		};
+
+		template <typename TPredicate>
+		struct FilterAdaptor : AdaptorTag
+		{
+			static constexpr bool kElementwise = true;
+			template <typename TView>
+			auto Apply(TView&& view) const
+			{
+				return FilterView<std::remove_cvref_t<TView>, TPredicate>{std::forward<TView>(view), Predicate};
+			}
+			TPredicate Predicate;
+		};
+
+		struct TakeAdaptor : AdaptorTag
+		{
+			static constexpr bool kElementwise = false;
+			template <typename TView>
+			auto Apply(TView&& view) const
+			{
+				return TakeView<std::remove_cvref_t<TView>>{std::forward<TView>(view), Count};
+			}
+			int Count;
+		};
+
+		struct EnumerateAdaptor : AdaptorTag
+		{
+			static constexpr bool kElementwise = false;
+			template <typename TView>
+			auto Apply(TView&& view) const
+			{
+				return EnumerateView<std::remove_cvref_t<TView>>{std::forward<TView>(view)};
+			}
+		};
+
+		template <typename TOther>
+		struct ZipAdaptor : AdaptorTag
+		{
+			static constexpr bool kElementwise = false;
+			template <typename TView>
+			auto Apply(TView&& view) const
+			{
+				return ZipView<std::remove_cvref_t<TView>, TOther>{std::forward<TView>(view), Other};
+			}
+			TOther Other;
+		};
+
+		struct ChunkAdaptor : AdaptorTag
+		{
+			static constexpr bool kElementwise = false;
+			template <typename TView>
+			auto Apply(TView&& view) const
+			{
+				return ChunkView<std::remove_cvref_t<TView>>{std::forward<TView>(view), Size > 0 ? Size : 1};
+			}
+			int Size;
+		};
+
+		// two adaptors applied one after the other, what adaptor | adaptor builds
+		template <typename TFirst, typename TSecond>
+		struct Pipeline : AdaptorTag
+		{
+			static constexpr bool kElementwise = TFirst::kElementwise && TSecond::kElementwise;
+			template <typename TView>
+			auto Apply(TView&& view) const
+			{
+				return Second.Apply(First.Apply(std::forward<TView>(view)));
+			}
+			TFirst First;
+			TSecond Second;
+		};
+
+		// found by argument dependent lookup through the adaptor, sources may live in any namespace
+		template <typename TSource, typename TAdaptor>
+			requires(!IsAdaptor<TSource> && IsAdaptor<TAdaptor>)
+		auto operator|(TSource&& source, const TAdaptor& adaptor)
+		{
+			return adaptor.Apply(AsView(std::forward<TSource>(source)));
+		}
+
+		template <typename TFirst, typename TSecond>
+			requires(IsAdaptor<TFirst> && IsAdaptor<TSecond>)
+		Pipeline<TFirst, TSecond> operator|(const TFirst& first, const TSecond& second)
+		{
+			return {{}, first, second};
+		}
+	} // namespace adaptors_impl
+
+	// f(x) for each x, computed on dereference
+	template <typename TFunc>
+	adaptors_impl::MapAdaptor<std::decay_t<TFunc>> Map(TFunc&& func)
+	{
+		return {{}, std::forward<TFunc>(func)};
+	}
+
+	// the x for which predicate(x) holds
+	template <typename TPredicate>
+	adaptors_impl::FilterAdaptor<std::decay_t<TPredicate>> Filter(TPredicate&& predicate)
+	{
+		return {{}, std::forward<TPredicate>(predicate)};
+	}
+
+	// at most count elements
+	inline adaptors_impl::TakeAdaptor Take(int count) { return {{}, count}; }
+
+	// Enumerated{index, x}, index counts from 0
+	inline adaptors_impl::EnumerateAdaptor Enumerate() { return {}; }
+
+	// Zipped{x, y} with y taken from other in step
+	template <typename TOther>
+	adaptors_impl::ZipAdaptor<adaptors_impl::ViewOf<TOther>> Zip(TOther&& other)
+	{
+		return {{}, adaptors_impl::AsView(std::forward<TOther>(other))};
+	}
+
+	template <typename TFirst, typename TSecond>
+	auto Zip(TFirst&& first, TSecond&& second)
+	{
+		return ZipView<adaptors_impl::ViewOf<TFirst>, adaptors_impl::ViewOf<TSecond>>{
+			adaptors_impl::AsView(std::forward<TFirst>(first)), adaptors_impl::AsView(std::forward<TSecond>(second))};
+	}
+
+	// pieces of at most size elements
+	inline adaptors_impl::ChunkAdaptor Chunk(int size) { return {{}, size}; }
+
+	// sink(x) for every element. same elements as a range-for, but Map and Filter are run inside the
+	// source's own loop, so a filtering pipeline keeps the shape of a hand-written loop and vectorizes
+	template <typename TSource, typename TSink>
+	void ForEachElement(TSource&& source, TSink&& sink)
+	{
+		adaptors_impl::Each(adaptors_impl::AsView(std::forward<TSource>(source)), sink);
+	}
+
+	// sink(std::span<const T>) with up to BatchSize consecutive elements at a time, gathered in a buffer
+	// on the stack. lets a pipeline feed code that wants contiguous input (SIMD kernels, bulk inserts)
+	template <u32 BatchSize, typename TSource, typename TSink>
+	void ForEachBatch(TSource&& source, TSink&& sink)
+	{
+		const auto view = adaptors_impl::AsView(std::forward<TSource>(source));
+		using T = std::remove_cvref_t<decltype(*view.begin())>;
+		T batch[BatchSize];
+		u32 count = 0;
+		adaptors_impl::Each(view, [&](auto&& value) {
+			batch[count++] = std::forward<decltype(value)>(value);
+			if (count == BatchSize)
+			{
+				sink(std::span<const T>(batch, count));
+				count = 0;
+			}
+		});
+		if (count)
+			sink(std::span<const T>(batch, count));
+	}
+} // namespace vex
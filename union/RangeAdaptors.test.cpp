@@ -0,0 +1,185 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for RangeAdaptors.h, from the repository root:
+//	g++ -std=c++20 -fsanitize=address -I. union/RangeAdaptors.test.cpp -o rangeadaptors_test && ./rangeadaptors_test
+#include <cstdio>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "RangeAdaptors.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using namespace vex;
+
+namespace
+{
+	// what a range-for over the view yields, the reference every other way of walking it is held to
+	template <typename TView>
+	std::vector<int> Collect(const TView& view)
+	{
+		std::vector<int> out;
+		for (int value : view)
+			out.push_back(value);
+		return out;
+	}
+
+	template <typename TSource>
+	std::vector<int> CollectEach(TSource&& source)
+	{
+		std::vector<int> out;
+		ForEachElement(std::forward<TSource>(source), [&](int value) { out.push_back(value); });
+		return out;
+	}
+
+	void CheckMapFilterTake()
+	{
+		const std::vector<int> values = {1, 2, 3, 4, 5, 6, 7, 8};
+		const auto squares = values | Map([](int x) { return x * x; });
+		VEX_CHECK(Collect(squares) == std::vector<int>({1, 4, 9, 16, 25, 36, 49, 64}));
+
+		// the filter also drops a leading and a trailing run
+		const auto odd = values | Filter([](int x) { return x % 2 == 1 && x < 7; });
+		VEX_CHECK(Collect(odd) == std::vector<int>({1, 3, 5}));
+		VEX_CHECK(Collect(values | Filter([](int) { return false; })).empty());
+
+		VEX_CHECK(Collect(Range(100) | Take(3)) == std::vector<int>({0, 1, 2}));
+		VEX_CHECK(Collect(Range(2) | Take(5)) == std::vector<int>({0, 1}));
+		VEX_CHECK(Collect(Range(10) | Take(0)).empty() && Collect(Range(10) | Take(-1)).empty());
+		VEX_CHECK(Collect(Range(5, 5) | Map([](int x) { return x; })).empty());
+
+		// adaptors compose before they meet a source, the pipe is reusable
+		const auto pipe = Map([](int x) { return x * 3; }) | Filter([](int x) { return x % 2 == 0; }) | Take(3);
+		VEX_CHECK(Collect(values | pipe) == std::vector<int>({6, 12, 18}));
+		VEX_CHECK(Collect(Range(1, 4) | pipe) == std::vector<int>({6}));
+		VEX_CHECK(Collect(CRange<0, 4>() | pipe) == std::vector<int>({0, 6}));
+		VEX_CHECK(Collect(Strided(0, 10, 3) | pipe) == std::vector<int>({0, 18}));
+
+		// a container is referenced, a view sees writes made after it was built
+		std::vector<int> live = {1, 2};
+		const auto doubled = live | Map([](int x) { return 2 * x; });
+		live[1] = 10;
+		VEX_CHECK(Collect(doubled) == std::vector<int>({2, 20}));
+
+		// spans are copied, an rvalue one is fine
+		VEX_CHECK(Collect(std::span<const int>(values).subspan(6) | Map([](int x) { return -x; })) ==
+				  std::vector<int>({-7, -8}));
+	}
+
+	void CheckEnumerateZip()
+	{
+		std::vector<std::string> names = {"a", "b", "c"};
+		int indexSum = 0;
+		std::string joined;
+		for (auto [index, name] : names | Enumerate() | Take(2))
+		{
+			indexSum += index;
+			joined += name;
+		}
+		VEX_CHECK(indexSum == 1 && joined == "ab");
+
+		// the value is the container's reference, writes go through
+		for (auto item : names | Enumerate())
+			item.Value += std::to_string(item.Index);
+		VEX_CHECK(names[0] == "a0" && names[2] == "c2");
+
+		// both forms stop with the shorter side
+		const std::vector<float> weights = {0.5f, 2.0f};
+		float total = 0;
+		int pairs = 0;
+		for (auto [value, weight] : Range(1, 10) | Zip(weights))
+		{
+			total += (float)value * weight;
+			++pairs;
+		}
+		VEX_CHECK(pairs == 2 && total == 4.5f);
+		pairs = 0;
+		for (auto pair : Zip(weights, Range(100)))
+			pairs += pair.Second == pairs;
+		VEX_CHECK(pairs == 2);
+		VEX_CHECK(Collect(Zip(Range(3), Range(0)) | Map([](auto pair) { return pair.First; })).empty());
+	}
+
+	void CheckChunk()
+	{
+		// a Range is cut into Ranges, the last one short
+		std::vector<int> starts, sizes;
+		const auto chunks = Range(3, 13) | Chunk(4);
+		for (Range chunk : chunks)
+		{
+			starts.push_back(chunk.Start);
+			sizes.push_back(chunk.Size());
+		}
+		VEX_CHECK(starts == std::vector<int>({3, 7, 11}) && sizes == std::vector<int>({4, 4, 2}));
+		VEX_CHECK(chunks.Count() == 3 && (Range(8) | Chunk(4)).Count() == 2);
+		VEX_CHECK((Range(0) | Chunk(4)).Count() == 0);
+
+		// a size below one is taken as one rather than looping forever
+		int singles = 0;
+		for (Range chunk : Range(3) | Chunk(0))
+			singles += chunk.Size() == 1;
+		VEX_CHECK(singles == 3);
+
+		// other sources are cut into Take views over the rest of the source
+		const std::vector<int> values = {1, 2, 3, 4, 5, 6, 7};
+		std::vector<std::vector<int>> pieces;
+		for (auto piece : values | Filter([](int x) { return x != 4; }) | Chunk(4))
+			pieces.push_back(Collect(piece));
+		VEX_CHECK(pieces.size() == 2 && pieces[0] == std::vector<int>({1, 2, 3, 5}) && pieces[1] == std::vector<int>({6, 7}));
+	}
+
+	void CheckSinks()
+	{
+		// ForEachElement pushes through Map and Filter, the elements and their order match a range-for
+		const std::vector<int> values = {5, 1, 4, 2, 3, 9, 8};
+		const auto pipe = Map([](int x) { return x * 10; }) | Filter([](int x) { return x > 25; });
+		VEX_CHECK(CollectEach(values | pipe) == Collect(values | pipe));
+		VEX_CHECK(CollectEach(values | pipe | Take(2)) == std::vector<int>({50, 40}));
+		VEX_CHECK(CollectEach(Range(4) | Enumerate() | Map([](auto item) { return item.Index * item.Value; })) ==
+				  std::vector<int>({0, 1, 4, 9}));
+		VEX_CHECK(CollectEach(values).size() == values.size());
+
+		// full batches, then the tail
+		std::vector<size_t> batchSizes;
+		std::vector<int> batched;
+		ForEachBatch<4>(Range(10) | Filter([](int x) { return x != 5; }), [&](std::span<const int> batch) {
+			batchSizes.push_back(batch.size());
+			batched.insert(batched.end(), batch.begin(), batch.end());
+		});
+		VEX_CHECK(batchSizes == std::vector<size_t>({4, 4, 1}));
+		VEX_CHECK(batched == std::vector<int>({0, 1, 2, 3, 4, 6, 7, 8, 9}));
+
+		// an exact multiple has no empty tail call, an empty source no call at all
+		int calls = 0;
+		ForEachBatch<4>(Range(8), [&](std::span<const int>) { ++calls; });
+		ForEachBatch<4>(Range(0), [&](std::span<const int>) { ++calls; });
+		VEX_CHECK(calls == 2);
+
+		// element types other than int, read from a container the batch copies out of
+		const std::vector<std::string> words = {"x", "yy", "zzz"};
+		size_t letters = 0;
+		ForEachBatch<2>(words, [&](std::span<const std::string> batch) {
+			for (const std::string& word : batch)
+				letters += word.size();
+		});
+		VEX_CHECK(letters == 6);
+	}
+} // namespace
+
+int main()
+{
+	CheckMapFilterTake();
+	CheckEnumerateZip();
+	CheckChunk();
+	CheckSinks();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// Ranges.h loop shapes against the hand-written loops they stand for, from the repository root:
+//	g++ -std=c++20 -O3 -march=native -DNDEBUG -I. union/Ranges.bench.cpp -o ranges_bench
+// prints ns per element, best of 3. -O3 because gcc's -O2 cost model skips loops that need an alias check
+// or a scalar tail, hand-written or not. to see which loops the compiler vectorized add
+//	-fopt-info-vec-optimized=/dev/stdout	(gcc: "loop vectorized" with the kernel's line)
+//	-Rpass=loop-vectorize					(clang)
+// every kernel is noinline so its report line points into this file
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "Ranges.h"
+
+namespace
+{
+	// keeps results alive so the measured loops are not optimised out
+	volatile float gSink = 0.f;
+
+	template <typename TFunc>
+	double NsPerOp(size_t ops, TFunc&& func)
+	{
+		double best = 1e30;
+		for (int run = 0; run < 3; ++run)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			func();
+			const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+			best = elapsed.count() < best ? elapsed.count() : best;
+		}
+		return best / (double)ops;
+	}
+
+	// y = a * x + y over n elements
+	[[gnu::noinline]] void SaxpyPlain(float a, const float* x, float* y, int n)
+	{
+		for (int i = 0; i < n; ++i)
+			y[i] = a * x[i] + y[i];
+	}
+	[[gnu::noinline]] void SaxpyRange(float a, const float* x, float* y, int n)
+	{
+		for (int i : vex::Range(n))
+			y[i] = a * x[i] + y[i];
+	}
+	[[gnu::noinline]] void SaxpyStrided(float a, const float* x, float* y, int n)
+	{
+		for (int i : vex::Strided(0, n, 1))
+			y[i] = a * x[i] + y[i];
+	}
+	[[gnu::noinline]] void SaxpyBlocked(float a, const float* x, float* y, int n)
+	{
+		vex::ForEachBlocked<16>(vex::Range(n), [&](int i) { y[i] = a * x[i] + y[i]; });
+	}
+
+	// every other element, the stride the compiler has to prove before it vectorizes
+	[[gnu::noinline]] void EvenPlain(float* y, int n)
+	{
+		for (int i = 0; i < n; i += 2)
+			y[i] *= 0.5f;
+	}
+	[[gnu::noinline]] void EvenStrided(float* y, int n)
+	{
+		for (int i : vex::Strided(0, n, 2))
+			y[i] *= 0.5f;
+	}
+
+	// out = transpose(in), side x side
+	[[gnu::noinline]] void TransposePlain(const float* in, float* out, int side)
+	{
+		for (int y = 0; y < side; ++y)
+		{
+			for (int x = 0; x < side; ++x)
+				out[x * side + y] = in[y * side + x];
+		}
+	}
+	[[gnu::noinline]] void TransposeTiled(const float* in, float* out, int side)
+	{
+		for (const vex::Tile2D tile : vex::Tiled(vex::Range(side), vex::Range(side), 32, 32))
+		{
+			for (int y : tile.Y)
+			{
+				for (int x : tile.X)
+					out[x * side + y] = in[y * side + x];
+			}
+		}
+	}
+
+	void Row(const char* name, double ns, const std::vector<float>& result, const std::vector<float>& expected)
+	{
+		std::printf("%-18s %8.3f%s\n", name, ns, result == expected ? "" : "   MISMATCH");
+		gSink = gSink + result[result.size() / 2];
+	}
+
+	void RunSaxpy(int n)
+	{
+		std::vector<float> x(n), base(n);
+		for (int i = 0; i < n; ++i)
+		{
+			x[i] = (float)(i % 17);
+			base[i] = (float)(i % 5);
+		}
+		// every run starts from the same y, so the outputs can be compared
+		const auto measure = [&](void (*kernel)(float, const float*, float*, int), std::vector<float>& y) {
+			return NsPerOp((size_t)n * 100, [&] {
+				y = base;
+				for (int rep = 0; rep < 100; ++rep)
+					kernel(0.5f, x.data(), y.data(), n);
+			});
+		};
+		std::vector<float> expected, y;
+		std::printf("saxpy, %d floats\n", n);
+		Row("plain loop", measure(SaxpyPlain, expected), expected, expected);
+		Row("Range", measure(SaxpyRange, y), y, expected);
+		Row("Strided(1)", measure(SaxpyStrided, y), y, expected);
+		Row("ForEachBlocked<16>", measure(SaxpyBlocked, y), y, expected);
+
+		const auto measureEven = [&](void (*kernel)(float*, int), std::vector<float>& out) {
+			return NsPerOp((size_t)n / 2 * 100, [&] {
+				out = base;
+				for (int rep = 0; rep < 100; ++rep)
+					kernel(out.data(), n);
+			});
+		};
+		std::printf("every other element, %d floats\n", n);
+		Row("plain loop", measureEven(EvenPlain, expected), expected, expected);
+		Row("Strided(2)", measureEven(EvenStrided, y), y, expected);
+	}
+
+	void RunTranspose(int side)
+	{
+		std::vector<float> in((size_t)side * side), expected(in.size()), out(in.size());
+		for (size_t i = 0; i < in.size(); ++i)
+			in[i] = (float)i;
+		const size_t n = in.size();
+		std::printf("transpose, %d x %d\n", side, side);
+		Row("plain loop", NsPerOp(n, [&] { TransposePlain(in.data(), expected.data(), side); }), expected, expected);
+		Row("Tiled 32x32", NsPerOp(n, [&] { TransposeTiled(in.data(), out.data(), side); }), out, expected);
+	}
+} // namespace
+
+int main()
+{
+	std::printf("%-18s %8s   (ns/element)\n", "loop", "time");
+	RunSaxpy(4096);
+	RunSaxpy(1 << 20);
+	RunTranspose(2048);
+	return 0;
+}
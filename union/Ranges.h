@@ -0,0 +1,269 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <cassert>
+
+#include "CoreTemplates.h"
+
+// loop shapes on top of Range. every iterator here is a couple of ints compared against
+// impl::__vexSentinel, and trip counts are computed up front, so loops keep the form
+// compilers vectorize:
+//	for (int i : Strided(Range(n), 4)) ...				0, 4, 8, ...
+//	ForEachBlocked<8>(Range(n), [&](int i) { ... });	inner loop of exactly 8, then the tail
+//	for (Tile2D tile : Tiled(Range(h), Range(w), 64, 64))
+//		for (int y : tile.Y) for (int x : tile.X) ...
+namespace vex
+{
+	// Start, Start + Step, ... while before End. Step may be negative, never zero
+	struct StridedRange
+	{
+		struct Iterator
+		{
+			friend bool operator==(Iterator lhs, impl::__vexSentinel) { return lhs.Left == 0; }
+			friend bool operator==(impl::__vexSentinel lhs, Iterator rhs) { return rhs == lhs; }
+			friend bool operator!=(Iterator lhs, impl::__vexSentinel rhs) { return !(lhs == rhs); }
+			friend bool operator!=(impl::__vexSentinel lhs, Iterator rhs) { return !(lhs == rhs); }
+
+			inline int operator*() const { return Current; }
+			inline Iterator& operator++()
+			{
+				Current += Step;
+				--Left;
+				return *this;
+			}
+
+			int Current;
+			int Step;
+			int Left;
+		};
+
+		constexpr StridedRange(int start, int end, int step) : Start(start), Step(step), Count(CountOf(start, end, step))
+		{
+		}
+
+		// a zero step asserts, and is an empty range when asserts are off
+		static constexpr int CountOf(int start, int end, int step)
+		{
+			assert(step != 0 && "Strided step must not be zero");
+			if (step > 0)
+				return end > start ? (end - start + step - 1) / step : 0;
+			if (step < 0)
+				return start > end ? (start - end - step - 1) / -step : 0;
+			return 0;
+		}
+
+		Iterator begin() const noexcept { return Iterator{Start, Step, Count}; }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+		int Size() const noexcept { return Count; }
+
+		int Start;
+		int Step;
+		int Count;
+	};
+
+	inline StridedRange Strided(Range range, int step) { return StridedRange(range.Start, range.End, step); }
+	inline StridedRange Strided(int start, int end, int step) { return StridedRange(start, end, step); }
+
+	// compile time counterpart of StridedRange, CRange with any step
+	template <int Start, int End, int Step>
+	struct CStridedRange
+	{
+		static_assert(Step != 0, "CStridedRange step must not be zero");
+		static constexpr int kCount = StridedRange::CountOf(Start, End, Step);
+
+		StridedRange::Iterator begin() const noexcept { return StridedRange::Iterator{Start, Step, kCount}; }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+		static constexpr int Size() { return kCount; }
+	};
+
+	// the first index of every complete Width wide chunk of a Range, Remainder() is what is left.
+	// an inner loop over ZeroTo<Width> has a constant trip count and maps onto one or more SIMD registers
+	template <int Width>
+	struct BlockedRange
+	{
+		static_assert(Width > 0, "Blocked width must be positive");
+		static constexpr int kWidth = Width;
+
+		explicit BlockedRange(Range range)
+			: Blocks(range.Start, range.Start + range.Size() / Width * Width, Width),
+			  Tail(range.Start + range.Size() / Width * Width, range.End)
+		{
+		}
+
+		StridedRange::Iterator begin() const noexcept { return Blocks.begin(); }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+		int Size() const noexcept { return Blocks.Size(); }
+		Range Remainder() const noexcept { return Tail; }
+
+	private:
+		StridedRange Blocks;
+		Range Tail;
+	};
+
+	template <int Width>
+	BlockedRange<Width> Blocked(Range range)
+	{
+		return BlockedRange<Width>(range);
+	}
+
+	// func(i) for every i of range: Width at a time in a constant trip count loop, then the remainder
+	template <int Width, typename TFunc>
+	void ForEachBlocked(Range range, TFunc&& func)
+	{
+		const BlockedRange<Width> blocked(range);
+		for (const int base : blocked)
+		{
+			for (int lane = 0; lane < Width; ++lane)
+				func(base + lane);
+		}
+		for (const int i : blocked.Remainder())
+			func(i);
+	}
+
+	struct Tile2D
+	{
+		Range Y;
+		Range X;
+	};
+
+	struct Tile3D
+	{
+		Range Z;
+		Range Y;
+		Range X;
+	};
+
+	namespace ranges_impl
+	{
+		// [Start + index * Size, ...) clipped to End
+		inline Range TileOf(Range range, int size, int index)
+		{
+			const int start = range.Start + index * size;
+			return Range(start, start + size < range.End ? start + size : range.End);
+		}
+		inline int TileCount(Range range, int size)
+		{
+			assert(size > 0);
+			return (range.Size() + size - 1) / size;
+		}
+		// tile sizes below 1 are taken as 1, as Chunk does
+		inline int ClampTileSize(int size) { return size > 0 ? size : 1; }
+	} // namespace ranges_impl
+
+	// tiles of at most TileY x TileX over Y x X, row major, edge tiles are clipped. sizes below 1 are taken as 1
+	struct TiledRange2D
+	{
+		struct Iterator
+		{
+			friend bool operator==(const Iterator& lhs, impl::__vexSentinel) { return lhs.TileY >= lhs.Owner->CountY; }
+			friend bool operator==(impl::__vexSentinel lhs, const Iterator& rhs) { return rhs == lhs; }
+			friend bool operator!=(const Iterator& lhs, impl::__vexSentinel rhs) { return !(lhs == rhs); }
+			friend bool operator!=(impl::__vexSentinel lhs, const Iterator& rhs) { return !(lhs == rhs); }
+
+			Tile2D operator*() const
+			{
+				return Tile2D{ranges_impl::TileOf(Owner->Y, Owner->SizeY, TileY),
+					ranges_impl::TileOf(Owner->X, Owner->SizeX, TileX)};
+			}
+			Iterator& operator++()
+			{
+				if (++TileX == Owner->CountX)
+				{
+					TileX = 0;
+					++TileY;
+				}
+				return *this;
+			}
+
+			const TiledRange2D* Owner;
+			int TileY;
+			int TileX;
+		};
+
+		TiledRange2D(Range y, Range x, int sizeY, int sizeX)
+			: Y(y), X(x), SizeY(ranges_impl::ClampTileSize(sizeY)), SizeX(ranges_impl::ClampTileSize(sizeX)),
+			  CountY(ranges_impl::TileCount(y, SizeY)), CountX(ranges_impl::TileCount(x, SizeX))
+		{
+			if (CountX == 0)
+				CountY = 0;
+		}
+
+		Iterator begin() const noexcept { return Iterator{this, 0, 0}; }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+		int Size() const noexcept { return CountY * CountX; }
+
+		Range Y;
+		Range X;
+		int SizeY;
+		int SizeX;
+		int CountY;
+		int CountX;
+	};
+
+	// tiles of at most TileZ x TileY x TileX, X fastest, edge tiles are clipped. sizes below 1 are taken as 1
+	struct TiledRange3D
+	{
+		struct Iterator
+		{
+			friend bool operator==(const Iterator& lhs, impl::__vexSentinel) { return lhs.TileZ >= lhs.Owner->CountZ; }
+			friend bool operator==(impl::__vexSentinel lhs, const Iterator& rhs) { return rhs == lhs; }
+			friend bool operator!=(const Iterator& lhs, impl::__vexSentinel rhs) { return !(lhs == rhs); }
+			friend bool operator!=(impl::__vexSentinel lhs, const Iterator& rhs) { return !(lhs == rhs); }
+
+			Tile3D operator*() const
+			{
+				return Tile3D{ranges_impl::TileOf(Owner->Z, Owner->SizeZ, TileZ),
+					ranges_impl::TileOf(Owner->Y, Owner->SizeY, TileY), ranges_impl::TileOf(Owner->X, Owner->SizeX, TileX)};
+			}
+			Iterator& operator++()
+			{
+				if (++TileX == Owner->CountX)
+				{
+					TileX = 0;
+					if (++TileY == Owner->CountY)
+					{
+						TileY = 0;
+						++TileZ;
+					}
+				}
+				return *this;
+			}
+
+			const TiledRange3D* Owner;
+			int TileZ;
+			int TileY;
+			int TileX;
+		};
+
+		TiledRange3D(Range z, Range y, Range x, int sizeZ, int sizeY, int sizeX)
+			: Z(z), Y(y), X(x), SizeZ(ranges_impl::ClampTileSize(sizeZ)), SizeY(ranges_impl::ClampTileSize(sizeY)),
+			  SizeX(ranges_impl::ClampTileSize(sizeX)), CountZ(ranges_impl::TileCount(z, SizeZ)),
+			  CountY(ranges_impl::TileCount(y, SizeY)), CountX(ranges_impl::TileCount(x, SizeX))
+		{
+			if (CountY == 0 || CountX == 0)
+				CountZ = 0;
+		}
+
+		Iterator begin() const noexcept { return Iterator{this, 0, 0, 0}; }
+		impl::__vexSentinel end() const noexcept { return impl::__vexSentinel{}; }
+		int Size() const noexcept { return CountZ * CountY * CountX; }
+
+		Range Z;
+		Range Y;
+		Range X;
+		int SizeZ;
+		int SizeY;
+		int SizeX;
+		int CountZ;
+		int CountY;
+		int CountX;
+	};
+
+	inline TiledRange2D Tiled(Range y, Range x, int sizeY, int sizeX) { return TiledRange2D(y, x, sizeY, sizeX); }
+	inline TiledRange3D Tiled(Range z, Range y, Range x, int sizeZ, int sizeY, int sizeX)
+	{
+		return TiledRange3D(z, y, x, sizeZ, sizeY, sizeX);
+	}
+} // namespace vex
@@ -0,0 +1,77 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for Ranges.h, from the repository root:
+//	g++ -std=c++20 -I. union/Ranges.test.cpp -o ranges_test && ./ranges_test
+#include <cstdio>
+#include <vector>
+
+#include "Ranges.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+static_assert(vex::StridedRange::CountOf(0, 10, 3) == 4 && vex::StridedRange::CountOf(10, 0, -3) == 4);
+static_assert(vex::StridedRange::CountOf(5, 5, 1) == 0 && vex::StridedRange::CountOf(0, 10, -1) == 0);
+static_assert(vex::CStridedRange<9, -1, -2>::Size() == 5);
+
+namespace
+{
+	std::vector<int> Collect(const vex::StridedRange& range)
+	{
+		std::vector<int> out;
+		for (int i : range)
+			out.push_back(i);
+		return out;
+	}
+
+	// every cell of y x x covered by exactly one tile
+	int CountCovered(vex::TiledRange2D tiled, int height, int width)
+	{
+		std::vector<int> cells((size_t)height * width);
+		int tiles = 0;
+		for (const vex::Tile2D tile : tiled)
+		{
+			++tiles;
+			for (int y : tile.Y)
+			{
+				for (int x : tile.X)
+					++cells[(size_t)y * width + x];
+			}
+		}
+		int once = 0;
+		for (int count : cells)
+			once += count == 1;
+		return tiles == tiled.Size() ? once : -1;
+	}
+} // namespace
+
+int main()
+{
+	VEX_CHECK((Collect(vex::Strided(vex::Range(1, 8), 3)) == std::vector<int>{1, 4, 7}));
+	VEX_CHECK((Collect(vex::Strided(3, -4, -3)) == std::vector<int>{3, 0, -3}));
+
+	VEX_CHECK(CountCovered(vex::Tiled(vex::Range(10), vex::Range(7), 4, 3), 10, 7) == 70);
+	// tile sizes below 1 are taken as 1 instead of dividing by zero
+	const vex::TiledRange2D unit = vex::Tiled(vex::Range(3), vex::Range(4), 0, -5);
+	VEX_CHECK(unit.SizeY == 1 && unit.SizeX == 1 && unit.Size() == 12);
+	VEX_CHECK(CountCovered(unit, 3, 4) == 12);
+	VEX_CHECK(vex::Tiled(vex::Range(0), vex::Range(4), 2, 2).Size() == 0);
+
+	const vex::TiledRange3D cube = vex::Tiled(vex::Range(2), vex::Range(3), vex::Range(5), 0, 2, 64);
+	int cells = 0;
+	for (const vex::Tile3D tile : cube)
+		cells += tile.Z.Size() * tile.Y.Size() * tile.X.Size();
+	VEX_CHECK(cube.Size() == 2 * 2 * 1 && cells == 30);
+
+	int blocked = 0;
+	vex::ForEachBlocked<8>(vex::Range(3, 30), [&](int i) { blocked += i; });
+	VEX_CHECK(blocked == (3 + 29) * 27 / 2);
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -0,0 +1,471 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "TupleColumns.h"
+
+// sort / partition / join / group-by over arrays of Tuples, row-wise (std::vector<Tuple>) or columnar (TupleColumns).
+// everything works on index permutations and flat arrays, no per-row allocations.
+namespace vex::relational
+{
+	static constexpr u32 kNoIndex = 0xffffffffu;
+
+	// read-only row view into TupleColumns, exposes the same Get<I>() as Tuple
+	template <typename... Types>
+	struct ColumnRow
+	{
+		const TupleColumns<Types...>& Columns;
+		std::size_t Index;
+
+		template <int I>
+		const auto& Get() const
+		{
+			return Columns.template Column<I>()[Index];
+		}
+	};
+
+	namespace agg
+	{
+		struct Count
+		{
+			u64 Value = 0;
+			template <typename TRow>
+			void Add(const TRow&)
+			{
+				++Value;
+			}
+		};
+
+		template <int I, typename T = i64>
+		struct Sum
+		{
+			T Value = 0;
+			template <typename TRow>
+			void Add(const TRow& row)
+			{
+				Value += (T)row.template Get<I>();
+			}
+		};
+
+		template <int I, typename T = i64>
+		struct Min
+		{
+			T Value = std::numeric_limits<T>::max();
+			template <typename TRow>
+			void Add(const TRow& row)
+			{
+				const T v = (T)row.template Get<I>();
+				Value = v < Value ? v : Value;
+			}
+		};
+
+		template <int I, typename T = i64>
+		struct Max
+		{
+			T Value = std::numeric_limits<T>::lowest();
+			template <typename TRow>
+			void Add(const TRow& row)
+			{
+				const T v = (T)row.template Get<I>();
+				Value = Value < v ? v : Value;
+			}
+		};
+
+		template <int I>
+		struct Avg
+		{
+			double Total = 0;
+			u64 Count = 0;
+			template <typename TRow>
+			void Add(const TRow& row)
+			{
+				Total += (double)row.template Get<I>();
+				++Count;
+			}
+			double Value() const { return Count ? Total / (double)Count : 0.0; }
+		};
+	} // namespace agg
+
+	namespace impl
+	{
+		// order preserving map of integral key to unsigned bits
+		template <typename TKey>
+		constexpr auto ToRadixKey(TKey key)
+		{
+			if constexpr (std::is_enum_v<TKey>)
+			{
+				return ToRadixKey(static_cast<std::underlying_type_t<TKey>>(key));
+			}
+			else if constexpr (std::is_same_v<TKey, bool>)
+			{
+				return (u8)key;
+			}
+			else
+			{
+				static_assert(std::is_integral_v<TKey>, "radix sort requires integral or enum key");
+				using TBits = std::make_unsigned_t<TKey>;
+				TBits bits = (TBits)key;
+				if constexpr (std::is_signed_v<TKey>)
+					bits ^= TBits(1) << (sizeof(TKey) * 8 - 1);
+				return bits;
+			}
+		}
+
+		// stable LSD radix sort, 8 bit digits. all digit histograms are built in a single pass
+		// and digits shared by every key are skipped. returns source indices in sorted order
+		template <typename TBits>
+		std::vector<u32> SortedOrder(std::vector<TBits>& keys)
+		{
+			constexpr u32 kDigits = sizeof(TBits);
+			const u32 count = (u32)keys.size();
+
+			std::vector<u32> order(count);
+			for (u32 i = 0; i < count; ++i)
+				order[i] = i;
+			if (count < 2)
+				return order;
+
+			std::vector<u32> histograms(kDigits * 256, 0);
+			for (const TBits key : keys)
+			{
+				for (u32 d = 0; d < kDigits; ++d)
+					++histograms[d * 256 + ((key >> (d * 8)) & 0xff)];
+			}
+
+			std::vector<TBits> keysTmp(count);
+			std::vector<u32> orderTmp(count);
+			for (u32 d = 0; d < kDigits; ++d)
+			{
+				u32* histogram = &histograms[d * 256];
+				const u32 shift = d * 8;
+				if (histogram[(keys[0] >> shift) & 0xff] == count)
+					continue;
+
+				u32 offset = 0;
+				for (u32 b = 0; b < 256; ++b)
+				{
+					const u32 bucketSize = histogram[b];
+					histogram[b] = offset;
+					offset += bucketSize;
+				}
+				for (u32 i = 0; i < count; ++i)
+				{
+					const u32 dst = histogram[(keys[i] >> shift) & 0xff]++;
+					keysTmp[dst] = keys[i];
+					orderTmp[dst] = order[i];
+				}
+				keys.swap(keysTmp);
+				order.swap(orderTmp);
+			}
+			return order;
+		}
+
+		template <typename T>
+		void Permute(std::vector<T>& values, const std::vector<u32>& order)
+		{
+			std::vector<T> result;
+			result.reserve(values.size());
+			for (const u32 i : order)
+				result.push_back(std::move(values[i]));
+			values.swap(result);
+		}
+
+		template <typename THashPolicy, typename TKey>
+		inline u32 HashKey(const TKey& key)
+		{
+			return (u32)tuple_impl::HashMember<THashPolicy>(key);
+		}
+
+		inline u32 NextPowerOfTwo(u32 v)
+		{
+			u32 result = 1;
+			while (result < v)
+				result <<= 1;
+			return result;
+		}
+
+		// build side partitions are sized to stay cache resident while their table is built and probed
+		static constexpr u32 kRowsPerPartition = 8 * 1024;
+		static constexpr u32 kMaxPartitionBits = 10;
+
+		inline u32 PartitionBitsFor(std::size_t buildRows)
+		{
+			u32 bits = 0;
+			while (bits < kMaxPartitionBits && (buildRows >> bits) > kRowsPerPartition)
+				++bits;
+			return bits;
+		}
+
+		template <typename TKey>
+		struct Partitioned
+		{
+			std::vector<TKey> Keys;
+			std::vector<u32> Hashes;
+			std::vector<u32> Indices; // position in source array
+			std::vector<u32> Offsets; // partition p is [Offsets[p], Offsets[p + 1])
+		};
+
+		// radix partition by low hash bits; higher bits are left for the per-partition table
+		template <typename THashPolicy, typename TKey>
+		Partitioned<TKey> PartitionKeys(std::span<const TKey> keys, u32 partitionBits)
+		{
+			const u32 count = (u32)keys.size();
+			const u32 partitionCount = 1u << partitionBits;
+			const u32 mask = partitionCount - 1;
+
+			std::vector<u32> hashes(count);
+			for (u32 i = 0; i < count; ++i)
+				hashes[i] = HashKey<THashPolicy>(keys[i]);
+
+			Partitioned<TKey> result;
+			result.Offsets.assign(partitionCount + 1, 0);
+			for (const u32 h : hashes)
+				++result.Offsets[(h & mask) + 1];
+			for (u32 p = 0; p < partitionCount; ++p)
+				result.Offsets[p + 1] += result.Offsets[p];
+
+			std::vector<u32> cursor(result.Offsets.begin(), result.Offsets.end() - 1);
+			result.Keys.resize(count);
+			result.Hashes.resize(count);
+			result.Indices.resize(count);
+			for (u32 i = 0; i < count; ++i)
+			{
+				const u32 dst = cursor[hashes[i] & mask]++;
+				result.Keys[dst] = keys[i];
+				result.Hashes[dst] = hashes[i];
+				result.Indices[dst] = i;
+			}
+			return result;
+		}
+
+		// emit(buildIndex, probeIndex) for every pair of equal keys
+		template <typename THashPolicy, typename TKey, typename TEmit>
+		void JoinKeys(std::span<const TKey> build, std::span<const TKey> probe, TEmit& emit)
+		{
+			if (build.empty() || probe.empty())
+				return;
+
+			const u32 partitionBits = PartitionBitsFor(build.size());
+			const auto b = PartitionKeys<THashPolicy>(build, partitionBits);
+			const auto p = PartitionKeys<THashPolicy>(probe, partitionBits);
+
+			std::vector<u32> heads;
+			std::vector<u32> next;
+			for (u32 part = 0; part < (1u << partitionBits); ++part)
+			{
+				const u32 buildBegin = b.Offsets[part];
+				const u32 buildCount = b.Offsets[part + 1] - buildBegin;
+				if (buildCount == 0 || p.Offsets[part] == p.Offsets[part + 1])
+					continue;
+
+				const u32 bucketMask = NextPowerOfTwo(buildCount) - 1;
+				heads.assign(bucketMask + 1, kNoIndex);
+				next.resize(buildCount);
+				for (u32 i = 0; i < buildCount; ++i)
+				{
+					const u32 bucket = (b.Hashes[buildBegin + i] >> partitionBits) & bucketMask;
+					next[i] = heads[bucket];
+					heads[bucket] = i;
+				}
+
+				for (u32 j = p.Offsets[part]; j < p.Offsets[part + 1]; ++j)
+				{
+					const u32 h = p.Hashes[j];
+					for (u32 e = heads[(h >> partitionBits) & bucketMask]; e != kNoIndex; e = next[e])
+					{
+						if (b.Hashes[buildBegin + e] == h && b.Keys[buildBegin + e] == p.Keys[j])
+							emit(b.Indices[buildBegin + e], p.Indices[j]);
+					}
+				}
+			}
+		}
+
+		// open addressing key -> group index, grows at 50% load
+		template <typename THashPolicy, typename TKey, typename... TAggs>
+		struct GroupTable
+		{
+			std::vector<TKey> Keys;
+			std::vector<Tuple<TAggs...>> States;
+			std::vector<u32> Slots; // group index + 1, 0 is empty
+			std::vector<u32> SlotHashes;
+
+			GroupTable() : Slots(16, 0), SlotHashes(16, 0) {}
+
+			template <typename TRow>
+			void Add(const TKey& key, const TRow& row, const Tuple<TAggs...>& prototype)
+			{
+				const u32 group = FindOrInsert(key, prototype);
+				ForEach(States[group], [&row](auto& aggregation) { aggregation.Add(row); });
+			}
+
+			u32 FindOrInsert(const TKey& key, const Tuple<TAggs...>& prototype)
+			{
+				const u32 h = HashKey<THashPolicy>(key);
+				const u32 mask = (u32)Slots.size() - 1;
+				for (u32 slot = h & mask;; slot = (slot + 1) & mask)
+				{
+					const u32 entry = Slots[slot];
+					if (entry == 0)
+					{
+						Keys.push_back(key);
+						States.push_back(prototype);
+						Slots[slot] = (u32)Keys.size();
+						SlotHashes[slot] = h;
+						if (Keys.size() * 2 > Slots.size())
+							Grow();
+						return (u32)Keys.size() - 1;
+					}
+					if (SlotHashes[slot] == h && Keys[entry - 1] == key)
+						return entry - 1;
+				}
+			}
+
+			void Grow()
+			{
+				std::vector<u32> slots(Slots.size() * 2, 0);
+				std::vector<u32> hashes(Slots.size() * 2, 0);
+				const u32 mask = (u32)slots.size() - 1;
+				for (u32 i = 0; i < Slots.size(); ++i)
+				{
+					if (Slots[i] == 0)
+						continue;
+					u32 slot = SlotHashes[i] & mask;
+					while (slots[slot] != 0)
+						slot = (slot + 1) & mask;
+					slots[slot] = Slots[i];
+					hashes[slot] = SlotHashes[i];
+				}
+				Slots.swap(slots);
+				SlotHashes.swap(hashes);
+			}
+
+			std::vector<Tuple<TKey, TAggs...>> Result()
+			{
+				std::vector<Tuple<TKey, TAggs...>> result;
+				result.reserve(Keys.size());
+				for (u32 g = 0; g < Keys.size(); ++g)
+				{
+					result.push_back(Apply(
+						[&](auto&... aggregations) { return Tuple<TKey, TAggs...>(Keys[g], aggregations...); },
+						States[g]));
+				}
+				return result;
+			}
+		};
+
+		template <int K, typename... Types>
+		auto ExtractKeys(const std::vector<Tuple<Types...>>& rows)
+		{
+			using TKey = std::decay_t<typename GetTypeByIndex<K, Types...>::type>;
+			std::vector<TKey> keys;
+			keys.reserve(rows.size());
+			for (const auto& row : rows)
+				keys.push_back(row.template Get<K>());
+			return keys;
+		}
+
+		template <typename TKeys>
+		auto ToRadixKeys(const TKeys& keys)
+		{
+			std::vector<decltype(ToRadixKey(keys[0]))> result;
+			result.reserve(keys.size());
+			for (const auto& key : keys)
+				result.push_back(ToRadixKey(key));
+			return result;
+		}
+	} // namespace impl
+
+	//////////////////////////////////////////////////////////////////////////
+	// radix sort, stable, integral/enum key member K
+
+	template <int K, typename... Types>
+	void RadixSortBy(std::vector<Tuple<Types...>>& rows)
+	{
+		auto keys = impl::ToRadixKeys(impl::ExtractKeys<K>(rows));
+		impl::Permute(rows, impl::SortedOrder(keys));
+	}
+
+	template <int K, typename... Types>
+	void RadixSortBy(TupleColumns<Types...>& columns)
+	{
+		auto keys = impl::ToRadixKeys(columns.template Column<K>());
+		const auto order = impl::SortedOrder(keys);
+		Apply([&order](auto&... column) { (..., impl::Permute(column, order)); }, columns.Columns);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// hash partitioning: reorders rows into 2^partitionBits partitions by hash of member K,
+	// returns offsets - partition p is [offsets[p], offsets[p + 1])
+
+	template <int K, typename THashPolicy = util::SHash_MURMUR, typename... Types>
+	std::vector<u32> PartitionByHash(std::vector<Tuple<Types...>>& rows, u32 partitionBits)
+	{
+		const auto keys = impl::ExtractKeys<K>(rows);
+		auto parts = impl::PartitionKeys<THashPolicy>(std::span(keys), partitionBits);
+		impl::Permute(rows, parts.Indices);
+		return std::move(parts.Offsets);
+	}
+
+	template <int K, typename THashPolicy = util::SHash_MURMUR, typename... Types>
+	std::vector<u32> PartitionByHash(TupleColumns<Types...>& columns, u32 partitionBits)
+	{
+		const auto& keys = columns.template Column<K>();
+		auto parts = impl::PartitionKeys<THashPolicy>(std::span(keys), partitionBits);
+		Apply([&parts](auto&... column) { (..., impl::Permute(column, parts.Indices)); }, columns.Columns);
+		return std::move(parts.Offsets);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// partitioned hash equi-join on left.Get<KL>() == right.Get<KR>().
+	// the table is built over 'right', pass the smaller array there
+
+	template <int KL, int KR, typename THashPolicy = util::SHash_MURMUR, typename... L, typename... R, typename TEmit>
+	void HashJoin(const std::vector<Tuple<L...>>& left, const std::vector<Tuple<R...>>& right, TEmit&& emit)
+	{
+		const auto leftKeys = impl::ExtractKeys<KL>(left);
+		const auto rightKeys = impl::ExtractKeys<KR>(right);
+		auto emitRows = [&](u32 r, u32 l) { emit(left[l], right[r]); };
+		impl::JoinKeys<THashPolicy>(std::span(rightKeys), std::span(leftKeys), emitRows);
+	}
+
+	// emit(leftRowIndex, rightRowIndex)
+	template <int KL, int KR, typename THashPolicy = util::SHash_MURMUR, typename... L, typename... R, typename TEmit>
+	void HashJoin(const TupleColumns<L...>& left, const TupleColumns<R...>& right, TEmit&& emit)
+	{
+		auto emitIndices = [&](u32 r, u32 l) { emit(l, r); };
+		impl::JoinKeys<THashPolicy>(
+			std::span(right.template Column<KR>()), std::span(left.template Column<KL>()), emitIndices);
+	}
+
+	//////////////////////////////////////////////////////////////////////////
+	// group by member K, result rows are Tuple<Key, Aggs...> in order of first appearance.
+	// an aggregation is any copyable type with template <typename TRow> void Add(const TRow&)
+
+	template <int K, typename THashPolicy = util::SHash_MURMUR, typename... Types, typename... TAggs>
+	auto GroupBy(const std::vector<Tuple<Types...>>& rows, TAggs... aggregations)
+	{
+		using TKey = std::decay_t<typename GetTypeByIndex<K, Types...>::type>;
+		const Tuple<TAggs...> prototype(aggregations...);
+		impl::GroupTable<THashPolicy, TKey, TAggs...> table;
+		for (const auto& row : rows)
+			table.Add(row.template Get<K>(), row, prototype);
+		return table.Result();
+	}
+
+	template <int K, typename THashPolicy = util::SHash_MURMUR, typename... Types, typename... TAggs>
+	auto GroupBy(const TupleColumns<Types...>& columns, TAggs... aggregations)
+	{
+		using TKey = std::decay_t<typename GetTypeByIndex<K, Types...>::type>;
+		const Tuple<TAggs...> prototype(aggregations...);
+		impl::GroupTable<THashPolicy, TKey, TAggs...> table;
+		const auto& keys = columns.template Column<K>();
+		for (std::size_t i = 0; i < keys.size(); ++i)
+			table.Add(keys[i], ColumnRow<Types...>{columns, i}, prototype);
+		return table.Result();
+	}
+} // namespace vex::relational
@@ -0,0 +1,278 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for Relational.h against std::stable_sort, a multimap join and a std::map group-by, from the repository root:
+//	g++ -std=c++20 -fsanitize=address -I. union/Relational.test.cpp -o relational_test && ./relational_test
+// every operation runs on the same rows as std::vector<Tuple> and as TupleColumns
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Relational.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using vex::Tuple;
+using vex::TupleColumns;
+namespace rel = vex::relational;
+
+namespace
+{
+	enum class Kind : i8
+	{
+		Low = -3,
+		Mid = 0,
+		High = 5
+	};
+
+	// key, payload, the row's original position (tells a stable order from an unstable one)
+	using Row = Tuple<int, i64, u32>;
+
+	std::vector<Row> MakeRows(u32 count, int keyRange, u32 seed)
+	{
+		std::mt19937 rng(seed);
+		std::vector<Row> rows;
+		for (u32 i = 0; i < count; ++i)
+		{
+			const int key = (int)((i64)(rng() % (2 * (u64)keyRange + 1)) - keyRange); // negative, zero and positive
+			rows.push_back(Row(key, (i64)(rng() % 2001) - 1000, i));
+		}
+		return rows;
+	}
+
+	template <typename... Types>
+	TupleColumns<Types...> ToColumns(const std::vector<Tuple<Types...>>& rows)
+	{
+		TupleColumns<Types...> columns;
+		for (const auto& row : rows)
+			columns.PushBack(row);
+		return columns;
+	}
+
+	template <typename... Types>
+	bool SameRows(const TupleColumns<Types...>& columns, const std::vector<Tuple<Types...>>& rows)
+	{
+		if (columns.Size() != rows.size())
+			return false;
+		for (std::size_t i = 0; i < rows.size(); ++i)
+		{
+			if (columns.Row(i) != rows[i])
+				return false;
+		}
+		return true;
+	}
+
+	template <int K, typename... Types>
+	void CheckSortOf(const std::vector<Tuple<Types...>>& input)
+	{
+		std::vector<Tuple<Types...>> expected = input;
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const auto& lhs, const auto& rhs) { return lhs.template Get<K>() < rhs.template Get<K>(); });
+
+		std::vector<Tuple<Types...>> rows = input;
+		rel::RadixSortBy<K>(rows);
+		VEX_CHECK(rows == expected);
+
+		TupleColumns<Types...> columns = ToColumns(input);
+		rel::RadixSortBy<K>(columns);
+		VEX_CHECK(SameRows(columns, expected));
+	}
+
+	void CheckRadixSort()
+	{
+		// few distinct keys, so stability is visible in the third member
+		CheckSortOf<0>(MakeRows(5000, 20, 1));
+		CheckSortOf<0>(MakeRows(5000, 1 << 30, 2));
+		CheckSortOf<1>(MakeRows(3000, 5, 3));
+		CheckSortOf<0>(std::vector<Row>());
+		CheckSortOf<0>(std::vector<Row>{Row(-1, 0, 0)});
+
+		// extremes of signed and unsigned keys, bools and enums with negative values
+		std::vector<Tuple<i64, u32>> wide;
+		const i64 extremes[] = {std::numeric_limits<i64>::min(), -1, 0, 1, std::numeric_limits<i64>::max()};
+		for (u32 i = 0; i < 50; ++i)
+			wide.push_back(Tuple<i64, u32>(extremes[(i * 7) % 5], i));
+		CheckSortOf<0>(wide);
+
+		std::vector<Tuple<u16, bool, Kind, u32>> small;
+		const Kind kinds[] = {Kind::High, Kind::Low, Kind::Mid};
+		for (u32 i = 0; i < 300; ++i)
+			small.push_back(Tuple<u16, bool, Kind, u32>((u16)(65535 - i * 211), i % 3 == 0, kinds[i % 3], i));
+		CheckSortOf<0>(small);
+		CheckSortOf<1>(small);
+		CheckSortOf<2>(small);
+	}
+
+	void CheckPartition()
+	{
+		for (const u32 bits : {0u, 1u, 4u})
+		{
+			const std::vector<Row> input = MakeRows(2000, 300, 4 + bits);
+			std::vector<Row> rows = input;
+			const std::vector<u32> offsets = rel::PartitionByHash<0>(rows, bits);
+			VEX_CHECK(offsets.size() == (1u << bits) + 1 && offsets.front() == 0 && offsets.back() == rows.size());
+
+			// every row lands in the partition of its hash, in its original relative order
+			u32 placed = 0, ordered = 0;
+			for (u32 p = 0; p < (1u << bits); ++p)
+			{
+				for (u32 i = offsets[p]; i < offsets[p + 1]; ++i)
+				{
+					const u32 hash = (u32)vex::tuple_impl::HashMember<vex::util::SHash_MURMUR>(rows[i].Get<0>());
+					placed += (hash & ((1u << bits) - 1)) == p;
+					ordered += i == offsets[p] || rows[i - 1].Get<2>() < rows[i].Get<2>();
+				}
+			}
+			VEX_CHECK(placed == rows.size() && ordered == rows.size());
+			std::vector<Row> sorted = rows;
+			std::sort(sorted.begin(), sorted.end(), [](const Row& l, const Row& r) { return l.Get<2>() < r.Get<2>(); });
+			VEX_CHECK(sorted == input);
+
+			TupleColumns<int, i64, u32> columns = ToColumns(input);
+			VEX_CHECK(rel::PartitionByHash<0>(columns, bits) == offsets);
+			VEX_CHECK(SameRows(columns, rows));
+		}
+
+		std::vector<Row> empty;
+		const std::vector<u32> offsets = rel::PartitionByHash<0>(empty, 2);
+		VEX_CHECK(offsets == std::vector<u32>(5, 0));
+	}
+
+	// (left position, right position) pairs, sorted
+	using Pairs = std::vector<std::pair<u32, u32>>;
+
+	Pairs ReferenceJoin(const std::vector<Row>& left, const std::vector<Tuple<i64, int>>& right)
+	{
+		std::unordered_multimap<int, u32> byKey;
+		for (u32 r = 0; r < right.size(); ++r)
+			byKey.emplace(right[r].Get<1>(), r);
+		Pairs pairs;
+		for (u32 l = 0; l < left.size(); ++l)
+		{
+			const auto [first, last] = byKey.equal_range(left[l].Get<0>());
+			for (auto it = first; it != last; ++it)
+				pairs.emplace_back(l, it->second);
+		}
+		std::sort(pairs.begin(), pairs.end());
+		return pairs;
+	}
+
+	void CheckJoinOf(const std::vector<Row>& left, const std::vector<Tuple<i64, int>>& right)
+	{
+		const Pairs expected = ReferenceJoin(left, right);
+
+		Pairs rows;
+		rel::HashJoin<0, 1>(left, right, [&](const Row& l, const Tuple<i64, int>& r) {
+			rows.emplace_back(l.Get<2>(), (u32)r.Get<0>());
+		});
+		std::sort(rows.begin(), rows.end());
+		VEX_CHECK(rows == expected);
+
+		Pairs columns;
+		rel::HashJoin<0, 1>(ToColumns(left), ToColumns(right), [&](u32 l, u32 r) { columns.emplace_back(l, r); });
+		std::sort(columns.begin(), columns.end());
+		VEX_CHECK(columns == expected);
+	}
+
+	std::vector<Tuple<i64, int>> MakeBuildSide(u32 count, int keyRange, u32 seed)
+	{
+		std::mt19937 rng(seed);
+		std::vector<Tuple<i64, int>> rows;
+		for (u32 i = 0; i < count; ++i)
+			rows.push_back(Tuple<i64, int>((i64)i, (int)(rng() % (2 * keyRange + 1)) - keyRange));
+		return rows;
+	}
+
+	void CheckHashJoin()
+	{
+		// duplicates on both sides, then a build side large enough to be partitioned
+		CheckJoinOf(MakeRows(500, 40, 10), MakeBuildSide(300, 40, 11));
+		CheckJoinOf(MakeRows(30000, 20000, 12), MakeBuildSide(40000, 20000, 13));
+		CheckJoinOf(MakeRows(100, 5, 14), MakeBuildSide(100, 1000, 15));
+		CheckJoinOf(std::vector<Row>(), MakeBuildSide(100, 10, 16));
+		CheckJoinOf(MakeRows(100, 10, 17), std::vector<Tuple<i64, int>>());
+	}
+
+	struct Expected
+	{
+		u64 Count = 0;
+		i64 Sum = 0;
+		i64 Min = std::numeric_limits<i64>::max();
+		i64 Max = std::numeric_limits<i64>::lowest();
+	};
+
+	template <typename TResult>
+	void CompareGroups(const TResult& groups, const std::vector<Row>& rows)
+	{
+		std::map<int, Expected> expected;
+		std::vector<int> firstSeen;
+		for (const Row& row : rows)
+		{
+			const auto [it, inserted] = expected.try_emplace(row.Get<0>());
+			if (inserted)
+				firstSeen.push_back(row.Get<0>());
+			Expected& group = it->second;
+			const i64 value = row.Get<1>();
+			++group.Count;
+			group.Sum += value;
+			group.Min = std::min(group.Min, value);
+			group.Max = std::max(group.Max, value);
+		}
+
+		VEX_CHECK(groups.size() == expected.size());
+		u32 matching = 0;
+		for (std::size_t g = 0; g < groups.size() && g < firstSeen.size(); ++g)
+		{
+			const auto& [key, count, sum, min, max, avg] = groups[g];
+			const Expected& group = expected[key];
+			const double mean = (double)group.Sum / (double)group.Count;
+			matching += key == firstSeen[g] && count.Value == group.Count && sum.Value == group.Sum &&
+						min.Value == group.Min && max.Value == group.Max && avg.Value() == mean;
+		}
+		VEX_CHECK(matching == expected.size());
+	}
+
+	void CheckGroupBy()
+	{
+		for (const auto& rows : {MakeRows(10000, 50, 20), MakeRows(2000, 100000, 21), std::vector<Row>()})
+		{
+			const auto fromRows = rel::GroupBy<0>(rows, rel::agg::Count{}, rel::agg::Sum<1>{}, rel::agg::Min<1>{},
+				rel::agg::Max<1>{}, rel::agg::Avg<1>{});
+			CompareGroups(fromRows, rows);
+
+			const auto fromColumns = rel::GroupBy<0>(ToColumns(rows), rel::agg::Count{}, rel::agg::Sum<1>{},
+				rel::agg::Min<1>{}, rel::agg::Max<1>{}, rel::agg::Avg<1>{});
+			CompareGroups(fromColumns, rows);
+		}
+
+		// a single aggregation, over a signed 64 bit key
+		std::vector<Tuple<i64, u32>> wide;
+		for (u32 i = 0; i < 100; ++i)
+			wide.push_back(Tuple<i64, u32>(i % 2 ? std::numeric_limits<i64>::min() : -(i64)(i % 3), i));
+		const auto counts = rel::GroupBy<0>(wide, rel::agg::Count{});
+		VEX_CHECK(counts.size() == 4 && counts[0].Get<0>() == 0 && counts[1].Get<0>() == std::numeric_limits<i64>::min());
+		VEX_CHECK(counts[2].Get<0>() == -2 && counts[3].Get<0>() == -1);
+		VEX_CHECK(counts[1].Get<1>().Value == 50 && counts[0].Get<1>().Value == 17 && counts[3].Get<1>().Value == 16);
+	}
+} // namespace
+
+int main()
+{
+	CheckRadixSort();
+	CheckPartition();
+	CheckHashJoin();
+	CheckGroupBy();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
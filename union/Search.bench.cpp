@@ -0,0 +1,102 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// Search.h against std::lower_bound from 1K to 100M u32 keys, from the repository root:
+//	g++ -std=c++20 -O2 -march=native -DNDEBUG -I. union/Search.bench.cpp -o search_bench && ./search_bench [max keys]
+// prints ns per lookup of random keys, best of 3. the 100M row wants about 1.3 GB, pass a smaller
+// max to stop earlier. LinearLowerBound is only timed where it is meant to be used
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Search.h"
+
+using namespace vex::util;
+
+namespace
+{
+	// keeps results alive so the measured loops are not optimised out
+	volatile u64 gSink = 0;
+
+	template <typename TFunc>
+	double NsPerOp(size_t ops, TFunc&& func)
+	{
+		double best = 1e30;
+		for (int run = 0; run < 3; ++run)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			func();
+			const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+			best = elapsed.count() < best ? elapsed.count() : best;
+		}
+		return best / (double)ops;
+	}
+
+	// every lookup is independent, so out of order execution may overlap them as it can
+	template <typename TSearch>
+	double PerLookup(const std::vector<u32>& probes, TSearch&& search)
+	{
+		return NsPerOp(probes.size(), [&] {
+			u64 sum = 0;
+			for (u32 key : probes)
+				sum += search(key);
+			gSink = gSink + sum;
+		});
+	}
+
+	void Row(size_t count, const std::vector<u32>& probes)
+	{
+		// odd keys, so half the probes fall between two of them
+		std::vector<u32> sorted(count);
+		for (size_t i = 0; i < count; ++i)
+			sorted[i] = (u32)(2 * i + 1);
+
+		const double stdLower = PerLookup(probes, [&](u32 key) {
+			return (size_t)(std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin());
+		});
+		const double branchless = PerLookup(probes, [&](u32 key) { return LowerBound(sorted, key); });
+
+		std::vector<size_t> positions(probes.size());
+		const double batch = NsPerOp(probes.size(), [&] {
+			LowerBoundBatch(sorted, probes, positions);
+			gSink = gSink + positions.back();
+		});
+
+		double linear = 0;
+		if (count <= 1024)
+			linear = PerLookup(probes, [&](u32 key) { return LinearLowerBound(sorted.data(), sorted.size(), key); });
+
+		const EytzingerSet set(sorted);
+		sorted = std::vector<u32>(); // the Eytzinger rows run without the sorted copy taking memory
+		const double eytzinger = PerLookup(probes, [&](u32 key) { return set.LowerBound(key); });
+		const double eytzingerKey = PerLookup(probes, [&](u32 key) {
+			const u32* found = set.FindLowerBound(key);
+			return found ? *found : 0u;
+		});
+
+		std::printf("%10zu %10.1f %10.1f %10.1f %10.1f %10.1f", count, stdLower, branchless, batch, eytzinger, eytzingerKey);
+		if (linear > 0)
+			std::printf(" %10.1f", linear);
+		std::printf("\n");
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	const size_t maxKeys = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+	std::printf("%10s %10s %10s %10s %10s %10s %10s   (ns per lookup)\n", "keys", "std", "LowerBound", "Batch",
+		"Eytzinger", "EytzKey", "Linear");
+	for (size_t count = 1000; count <= maxKeys; count *= 10)
+	{
+		std::mt19937 rng(1);
+		std::vector<u32> probes(1000000);
+		for (u32& key : probes)
+			key = (u32)(rng() % (2 * count + 2));
+		Row(count, probes);
+	}
+	return 0;
+}
@@ -0,0 +1,251 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VEX_SEARCH_AVX2 1
+#else
+#define VEX_SEARCH_AVX2 0
+#endif
+
+#include "CoreTemplates.h"
+
+// searches over sorted keys, all returning lower/upper bound positions like std::lower_bound:
+//	LowerBound/UpperBound		branchless binary search with prefetch, any size
+//	LinearLowerBound			counts keys below, SIMD for 32 bit keys, for arrays of a few dozen keys
+//	LowerBoundBatch				many keys at once, the searches advance in lockstep so their cache misses overlap
+//	EytzingerSet				keys in BFS order: the next 4 levels of a search share one cache line, for large sets
+namespace vex::util
+{
+	namespace search_impl
+	{
+		template <typename T>
+		inline constexpr void Prefetch(const T* ptr)
+		{
+			if (!std::is_constant_evaluated())
+				__builtin_prefetch(ptr);
+		}
+
+		// the one step every search here is built from: the half is dropped with a conditional move
+		// instead of a branch, so the loop runs log2(n) times whatever the data
+		template <typename T, typename TBefore>
+		inline constexpr size_t BranchlessSearch(const T* data, size_t count, TBefore before)
+		{
+			if (count == 0)
+				return 0;
+			const T* base = data;
+			while (count > 1)
+			{
+				const size_t half = count / 2;
+				// the two places the next step can look at
+				Prefetch(base + half / 2);
+				Prefetch(base + half + half / 2);
+				base = before(base[half]) ? base + half : base;
+				count -= half;
+			}
+			return (size_t)(base - data) + before(*base);
+		}
+	} // namespace search_impl
+
+	// first position whose key is not less than key
+	template <typename T, typename TLess = std::less<>>
+	inline constexpr size_t LowerBound(const T* data, size_t count, const std::type_identity_t<T>& key, TLess less = {})
+	{
+		return search_impl::BranchlessSearch(data, count, [&](const T& value) { return less(value, key); });
+	}
+
+	// first position whose key is greater than key
+	template <typename T, typename TLess = std::less<>>
+	inline constexpr size_t UpperBound(const T* data, size_t count, const std::type_identity_t<T>& key, TLess less = {})
+	{
+		return search_impl::BranchlessSearch(data, count, [&](const T& value) { return !less(key, value); });
+	}
+
+	// the same over a sorted contiguous container (std::vector, std::span, std::array, ...). the key is
+	// taken as the container's value type, so LowerBound(values, 5) works for a std::vector<u32>
+	template <typename TContainer>
+	concept SortedKeys = std::ranges::contiguous_range<const TContainer&> && std::ranges::sized_range<const TContainer&>;
+
+	template <SortedKeys TContainer, typename TLess = std::less<>>
+	inline constexpr size_t LowerBound(
+		const TContainer& data, const std::ranges::range_value_t<TContainer>& key, TLess less = {})
+	{
+		return LowerBound(std::ranges::data(data), std::ranges::size(data), key, less);
+	}
+
+	template <SortedKeys TContainer, typename TLess = std::less<>>
+	inline constexpr size_t UpperBound(
+		const TContainer& data, const std::ranges::range_value_t<TContainer>& key, TLess less = {})
+	{
+		return UpperBound(std::ranges::data(data), std::ranges::size(data), key, less);
+	}
+
+	// lower bound as the number of keys below key: no dependency between iterations, 8 keys per
+	// compare for 32 bit ints and floats. beats the binary searches up to a few dozen keys
+	template <typename T>
+	inline size_t LinearLowerBound(const T* data, size_t count, const std::type_identity_t<T>& key)
+	{
+		size_t below = 0;
+		size_t i = 0;
+#if VEX_SEARCH_AVX2
+		if constexpr (std::is_same_v<T, i32> || std::is_same_v<T, u32> || std::is_same_v<T, float>)
+		{
+			__m256i total = _mm256_setzero_si256();
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256i less;
+				if constexpr (std::is_same_v<T, float>)
+				{
+					const __m256 values = _mm256_loadu_ps(data + i);
+					less = _mm256_castps_si256(_mm256_cmp_ps(values, _mm256_set1_ps(key), _CMP_LT_OQ));
+				}
+				else
+				{
+					// unsigned order is signed order with the top bit flipped
+					const __m256i flip = _mm256_set1_epi32(std::is_same_v<T, u32> ? (int)0x80000000u : 0);
+					const __m256i values =
+						_mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), flip);
+					less = _mm256_cmpgt_epi32(_mm256_xor_si256(_mm256_set1_epi32((int)key), flip), values);
+				}
+				total = _mm256_sub_epi32(total, less); // lanes are -1 where value < key
+			}
+			alignas(32) u32 lanes[8];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+			for (u32 lane : lanes)
+				below += lane;
+		}
+#endif
+		for (; i < count; ++i)
+			below += data[i] < key;
+		return below;
+	}
+
+	// out[i] = LowerBound(data, count, keys[i]). kLanes searches run interleaved, each step issues
+	// the loads of all of them before using any, so on arrays past the cache their misses overlap
+	// instead of being paid one after another
+	template <typename T, typename TLess = std::less<>>
+	void LowerBoundBatch(const T* data, size_t count, std::type_identity_t<std::span<const T>> keys,
+		std::span<size_t> out, TLess less = {})
+	{
+		constexpr u32 kLanes = 16;
+		size_t k = 0;
+		if (count > 0)
+		{
+			for (; k + kLanes <= keys.size(); k += kLanes)
+			{
+				const T* base[kLanes];
+				for (u32 lane = 0; lane < kLanes; ++lane)
+					base[lane] = data;
+				size_t left = count;
+				while (left > 1)
+				{
+					const size_t half = left / 2;
+					for (u32 lane = 0; lane < kLanes; ++lane)
+					{
+						search_impl::Prefetch(base[lane] + half / 2);
+						search_impl::Prefetch(base[lane] + half + half / 2);
+					}
+					for (u32 lane = 0; lane < kLanes; ++lane)
+						base[lane] = less(base[lane][half], keys[k + lane]) ? base[lane] + half : base[lane];
+					left -= half;
+				}
+				for (u32 lane = 0; lane < kLanes; ++lane)
+					out[k + lane] = (size_t)(base[lane] - data) + less(*base[lane], keys[k + lane]);
+			}
+		}
+		for (; k < keys.size(); ++k)
+			out[k] = LowerBound(data, count, keys[k], less);
+	}
+
+	template <SortedKeys TContainer, typename TLess = std::less<>>
+	void LowerBoundBatch(const TContainer& data, std::span<const std::ranges::range_value_t<TContainer>> keys,
+		std::span<size_t> out, TLess less = {})
+	{
+		LowerBoundBatch(std::ranges::data(data), std::ranges::size(data), keys, out, less);
+	}
+
+	// sorted keys rearranged in Eytzinger (BFS) order: node i has children 2i and 2i + 1, so the
+	// top of the tree stays cached and a search prefetches 4 levels ahead with a single line.
+	// LowerBound answers in sorted positions through a rank table, one more miss on large sets;
+	// FindLowerBound returns the key and does not touch the ranks
+	template <typename T, typename TLess = std::less<>>
+	struct EytzingerSet
+	{
+		EytzingerSet() = default;
+		explicit EytzingerSet(std::span<const T> sorted, TLess less = {}) : Less(less) { Build(sorted); }
+
+		// sorted must be in ascending order
+		void Build(std::span<const T> sorted)
+		{
+			Keys.resize(sorted.size() + 1);
+			Ranks.resize(sorted.size() + 1);
+			u32 next = 0;
+			Fill(sorted, next, 1);
+		}
+
+		size_t Size() const noexcept { return Keys.empty() ? 0 : Keys.size() - 1; }
+
+		// position of the lower bound of key in the sorted input, Size() if every key is below it
+		size_t LowerBound(const T& key) const
+		{
+			const size_t node = LowerBoundNode(key);
+			return node ? Ranks[node] : Size();
+		}
+
+		// the lower bound key itself, nullptr if every key is below it
+		const T* FindLowerBound(const T& key) const
+		{
+			const size_t node = LowerBoundNode(key);
+			return node ? &Keys[node] : nullptr;
+		}
+
+		// BFS ordered keys, index 0 is unused
+		std::span<const T> Data() const noexcept { return Keys; }
+
+	private:
+		static constexpr size_t kPrefetchStride = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+
+		// in order walk of the implicit tree hands out the sorted keys in order
+		void Fill(std::span<const T> sorted, u32& next, size_t node)
+		{
+			if (node > sorted.size())
+				return;
+			Fill(sorted, next, 2 * node);
+			Keys[node] = sorted[next];
+			Ranks[node] = next++;
+			Fill(sorted, next, 2 * node + 1);
+		}
+
+		// 0 when there is no lower bound
+		size_t LowerBoundNode(const T& key) const
+		{
+			const size_t count = Size();
+			const T* keys = Keys.data();
+			size_t node = 1;
+			while (node <= count)
+			{
+				search_impl::Prefetch(keys + node * kPrefetchStride);
+				node = 2 * node + Less(keys[node], key);
+			}
+			// past the answer the descent only turned right (set bits), drop those and the left turn at the answer
+			return node >> (std::countr_one(node) + 1);
+		}
+
+		std::vector<T> Keys;
+		std::vector<u32> Ranks;
+		TLess Less;
+	};
+
+	template <SortedKeys TContainer>
+	EytzingerSet(const TContainer&) -> EytzingerSet<std::ranges::range_value_t<TContainer>>;
+} // namespace vex::util
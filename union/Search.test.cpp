@@ -0,0 +1,130 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for Search.h against std::lower_bound / std::upper_bound, from the repository root:
+//	g++ -std=c++20 -march=native -fsanitize=address -I. union/Search.test.cpp -o search_test && ./search_test
+// -march=native takes the AVX2 path of LinearLowerBound where the machine has it
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "Search.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using namespace vex::util;
+
+namespace
+{
+	constexpr std::array<int, 6> kPrimes = {2, 3, 5, 7, 11, 13};
+	static_assert(LowerBound(kPrimes, 7) == 3 && UpperBound(kPrimes, 7) == 4 && LowerBound(kPrimes, 14) == 6);
+
+	// sorted keys with runs of duplicates, and the keys to look up: every stored key, the gaps, both ends
+	template <typename T>
+	void MakeKeys(size_t count, std::mt19937& rng, std::vector<T>& sorted, std::vector<T>& probes)
+	{
+		sorted.resize(count);
+		for (T& key : sorted)
+			key = (T)(rng() % (count * 2 + 1)) - (T)count;
+		std::sort(sorted.begin(), sorted.end());
+		probes.clear();
+		for (T key : sorted)
+		{
+			probes.push_back(key);
+			probes.push_back(key + 1);
+		}
+		probes.push_back((T)count * 3);
+		probes.push_back(-(T)count * 3);
+	}
+
+	template <typename T>
+	void CheckAgainstStd(size_t count, std::mt19937& rng)
+	{
+		std::vector<T> sorted, probes;
+		MakeKeys(count, rng, sorted, probes);
+		u32 lower = 0, upper = 0, linear = 0;
+		for (T key : probes)
+		{
+			const size_t expected = std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+			const size_t expectedUpper = std::upper_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+			lower += LowerBound(sorted, key) == expected && LowerBound(sorted.data(), sorted.size(), key) == expected;
+			upper += UpperBound(sorted, key) == expectedUpper;
+			linear += LinearLowerBound(sorted.data(), sorted.size(), key) == expected;
+		}
+		VEX_CHECK(lower == probes.size() && upper == probes.size() && linear == probes.size());
+
+		// probe counts that are and are not a multiple of the batch lanes
+		std::vector<size_t> positions(probes.size());
+		LowerBoundBatch(sorted, probes, positions);
+		u32 batch = 0;
+		for (size_t i = 0; i < probes.size(); ++i)
+			batch += positions[i] == (size_t)(std::lower_bound(sorted.begin(), sorted.end(), probes[i]) - sorted.begin());
+		VEX_CHECK(batch == probes.size());
+
+		const EytzingerSet set(sorted);
+		u32 eytzinger = 0;
+		for (T key : probes)
+		{
+			const size_t expected = std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin();
+			const T* found = set.FindLowerBound(key);
+			eytzinger += set.LowerBound(key) == expected && (expected == count ? !found : *found == sorted[expected]);
+		}
+		VEX_CHECK(set.Size() == count && eytzinger == probes.size());
+	}
+
+	void CheckConversions()
+	{
+		// the key is taken as the container's value type, an int literal searches a u32 vector
+		const std::vector<u32> values = {1, 4, 4, 9, 0x80000000u, 0xffffffffu};
+		VEX_CHECK(LowerBound(values, 4) == 1 && UpperBound(values, 4) == 3 && LowerBound(values, 10) == 4);
+		VEX_CHECK(LowerBound(values.data(), values.size(), 0x80000001u) == 5);
+		VEX_CHECK(LinearLowerBound(values.data(), values.size(), 0xfffffffeu) == 5);
+		VEX_CHECK(LowerBound(std::span<const u32>(values).first(3), 100) == 3);
+
+		std::vector<size_t> positions(3);
+		LowerBoundBatch(values, std::vector<u32>{0, 5, 0x90000000u}, positions);
+		VEX_CHECK(positions == std::vector<size_t>({0, 3, 5}));
+		LowerBoundBatch(values.data(), 0, std::vector<u32>{7}, std::span<size_t>(positions).first(1));
+		VEX_CHECK(positions[0] == 0);
+
+		// eight floats per compare, then the tail
+		std::vector<float> floats;
+		for (int i = 0; i < 21; ++i)
+			floats.push_back((float)i * 0.5f - 3.0f);
+		VEX_CHECK(LinearLowerBound(floats.data(), floats.size(), 0.25f) == 7);
+		VEX_CHECK(LinearLowerBound(floats.data(), floats.size(), 100.0f) == 21);
+
+		// descending order through the comparator
+		const std::vector<int> descending = {9, 7, 7, 3, 1};
+		VEX_CHECK(LowerBound(descending, 7, std::greater<>()) == 1 && UpperBound(descending, 7, std::greater<>()) == 3);
+		const EytzingerSet<int, std::greater<>> set(descending, std::greater<>());
+		VEX_CHECK(set.LowerBound(4) == 3 && *set.FindLowerBound(8) == 7 && !set.FindLowerBound(0));
+
+		const std::vector<int> empty;
+		VEX_CHECK(LowerBound(empty, 1) == 0 && UpperBound(empty, 1) == 0);
+		VEX_CHECK(EytzingerSet(empty).LowerBound(1) == 0);
+	}
+} // namespace
+
+int main()
+{
+	std::mt19937 rng(7);
+	for (size_t count : {0, 1, 2, 3, 7, 8, 15, 16, 17, 31, 64, 100, 1000, 4096, 100000})
+	{
+		CheckAgainstStd<int>(count, rng);
+		CheckAgainstStd<i64>(count, rng);
+	}
+	CheckAgainstStd<float>(1000, rng);
+	CheckConversions();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
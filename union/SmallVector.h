@@ -0,0 +1,349 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <cstring>
+#include <initializer_list>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "CoreTemplates.h"
+
+namespace vex
+{
+	// vector whose first N elements live inside the object, the heap is only touched past N.
+	// growth relocates trivially relocatable element types (traits::AreAllTriviallyRelocatable) with
+	// one memcpy, everything else is moved and destroyed one by one. like std::vector, growth copies
+	// elements whose move constructor may throw, so a throw leaves the vector as it was.
+	// heap buffers come from an optional std::pmr::memory_resource (e.g. memory::ArenaResource),
+	// ::operator new otherwise. the resource travels with the buffer when the vector is moved.
+	template <typename T, u32 N>
+	struct SmallVector
+	{
+		static_assert(N > 0, "SmallVector needs inline capacity, use std::vector otherwise");
+		static constexpr bool kTriviallyRelocatable = traits::AreAllTriviallyRelocatable<T>();
+		static constexpr bool kNothrowRelocate = kTriviallyRelocatable || std::is_nothrow_move_constructible_v<T>;
+
+		using value_type = T;
+		using iterator = T*;
+		using const_iterator = const T*;
+
+		SmallVector() = default;
+		explicit SmallVector(std::pmr::memory_resource* resource) : Resource(resource) {}
+		explicit SmallVector(u32 count) { Resize(count); }
+		SmallVector(u32 count, const T& value) { Resize(count, value); }
+		SmallVector(std::initializer_list<T> values)
+		{
+			Reserve((u32)values.size());
+			for (const T& value : values)
+				new (Items + Count++) T(value);
+		}
+
+		SmallVector(const SmallVector& other) : Resource(other.Resource)
+		{
+			Reserve(other.Count);
+			CopyConstruct(other.Items, other.Items + other.Count, Items);
+			Count = other.Count;
+		}
+		SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) { TakeFrom(other); }
+		~SmallVector()
+		{
+			Clear();
+			FreeBuffer();
+		}
+
+		SmallVector& operator=(const SmallVector& other)
+		{
+			if (this != &other)
+			{
+				Clear();
+				Reserve(other.Count);
+				CopyConstruct(other.Items, other.Items + other.Count, Items);
+				Count = other.Count;
+			}
+			return *this;
+		}
+		SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this != &other)
+			{
+				Clear();
+				FreeBuffer();
+				TakeFrom(other);
+			}
+			return *this;
+		}
+
+		u32 Size() const noexcept { return Count; }
+		u32 GetCapacity() const noexcept { return Capacity; }
+		bool IsEmpty() const noexcept { return Count == 0; }
+		// true while the elements are still in the inline buffer
+		bool IsInline() const noexcept { return Items == InlineItems(); }
+
+		T* Data() noexcept { return Items; }
+		const T* Data() const noexcept { return Items; }
+		T& operator[](u32 index) { return Items[index]; }
+		const T& operator[](u32 index) const { return Items[index]; }
+		T& Front() { return Items[0]; }
+		const T& Front() const { return Items[0]; }
+		T& Back() { return Items[Count - 1]; }
+		const T& Back() const { return Items[Count - 1]; }
+
+		T* begin() noexcept { return Items; }
+		T* end() noexcept { return Items + Count; }
+		const T* begin() const noexcept { return Items; }
+		const T* end() const noexcept { return Items + Count; }
+
+		template <typename... TArgs>
+		T& EmplaceBack(TArgs&&... args)
+		{
+			if (Count == Capacity)
+				return GrowAndEmplace(std::forward<TArgs>(args)...);
+			T* item = new (Items + Count) T(std::forward<TArgs>(args)...);
+			++Count;
+			return *item;
+		}
+		void PushBack(const T& value) { EmplaceBack(value); }
+		void PushBack(T&& value) { EmplaceBack(std::move(value)); }
+
+		void PopBack()
+		{
+			--Count;
+			Items[Count].~T();
+		}
+
+		// shifts the tail up by one, returns the inserted element
+		template <typename... TArgs>
+		T& Emplace(u32 index, TArgs&&... args)
+		{
+			if (index == Count)
+				return EmplaceBack(std::forward<TArgs>(args)...);
+			T value(std::forward<TArgs>(args)...); // args may refer into this vector
+			if (Count == Capacity)
+				Grow(Count + 1);
+			new (Items + Count) T(std::move(Items[Count - 1]));
+			for (u32 i = Count - 1; i > index; --i)
+				Items[i] = std::move(Items[i - 1]);
+			Items[index] = std::move(value);
+			++Count;
+			return Items[index];
+		}
+		void Insert(u32 index, const T& value) { Emplace(index, value); }
+		void Insert(u32 index, T&& value) { Emplace(index, std::move(value)); }
+
+		// removes [first, last), order of the remaining elements is kept
+		void Erase(u32 first, u32 last)
+		{
+			const u32 removed = last - first;
+			for (u32 i = first; i + removed < Count; ++i)
+				Items[i] = std::move(Items[i + removed]);
+			DestroyRange(Items + Count - removed, Items + Count);
+			Count -= removed;
+		}
+		void Erase(u32 index) { Erase(index, index + 1); }
+
+		// O(1) erase, the last element takes the erased one's place
+		void EraseSwapBack(u32 index)
+		{
+			if (index != Count - 1)
+				Items[index] = std::move(Items[Count - 1]);
+			PopBack();
+		}
+
+		void Clear() noexcept
+		{
+			DestroyRange(Items, Items + Count);
+			Count = 0;
+		}
+
+		void Reserve(u32 capacity)
+		{
+			if (capacity > Capacity)
+				Grow(capacity);
+		}
+
+		void Resize(u32 count)
+		{
+			Reserve(count);
+			for (; Count < count; ++Count)
+				new (Items + Count) T();
+			DestroyRange(Items + count, Items + Count);
+			Count = count;
+		}
+		void Resize(u32 count, const T& value)
+		{
+			Reserve(count);
+			for (; Count < count; ++Count)
+				new (Items + Count) T(value);
+			DestroyRange(Items + count, Items + Count);
+			Count = count;
+		}
+
+		friend bool operator==(const SmallVector& lhs, const SmallVector& rhs)
+		{
+			if (lhs.Count != rhs.Count)
+				return false;
+			for (u32 i = 0; i < lhs.Count; ++i)
+			{
+				if (!(lhs.Items[i] == rhs.Items[i]))
+					return false;
+			}
+			return true;
+		}
+		friend bool operator!=(const SmallVector& lhs, const SmallVector& rhs) { return !(lhs == rhs); }
+
+	private:
+		T* InlineItems() noexcept { return reinterpret_cast<T*>(InlineStorage); }
+		const T* InlineItems() const noexcept { return reinterpret_cast<const T*>(InlineStorage); }
+
+		static void DestroyRange(T* first, T* last) noexcept
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>)
+			{
+				for (; first != last; ++first)
+					first->~T();
+			}
+		}
+
+		static void CopyConstruct(const T* first, const T* last, T* dst)
+		{
+			if constexpr (kTriviallyRelocatable)
+			{
+				if (first != last)
+					std::memcpy((void*)dst, first, (last - first) * sizeof(T));
+			}
+			else
+			{
+				for (; first != last; ++first, ++dst)
+					new (dst) T(*first);
+			}
+		}
+
+		// destroys the first Count elements at First when it goes out of scope, unless Count was reset to 0.
+		// undoes a partly constructed range when an element constructor throws
+		struct ConstructedRange
+		{
+			T* First;
+			u32 Count = 0;
+			~ConstructedRange() { DestroyRange(First, First + Count); }
+		};
+
+		// moves count elements to raw storage at dst and ends their lifetime at src.
+		// MoveIfNoexcept copies elements whose move may throw, a throw then leaves src untouched
+		template <bool MoveIfNoexcept = true>
+		static void Relocate(T* src, u32 count, T* dst) noexcept(kNothrowRelocate)
+		{
+			if constexpr (kTriviallyRelocatable)
+			{
+				if (count)
+					std::memcpy((void*)dst, src, count * sizeof(T));
+			}
+			else
+			{
+				ConstructedRange built{dst};
+				for (; built.Count < count; ++built.Count)
+				{
+					if constexpr (MoveIfNoexcept)
+						new (dst + built.Count) T(std::move_if_noexcept(src[built.Count]));
+					else
+						new (dst + built.Count) T(std::move(src[built.Count]));
+				}
+				built.Count = 0;
+				DestroyRange(src, src + count);
+			}
+		}
+
+		T* AllocateBuffer(u32 capacity)
+		{
+			const size_t bytes = (size_t)capacity * sizeof(T);
+			if (Resource)
+				return static_cast<T*>(Resource->allocate(bytes, alignof(T)));
+			return static_cast<T*>(::operator new(bytes, std::align_val_t{alignof(T)}));
+		}
+
+		void DeallocateBuffer(T* items, u32 capacity) noexcept
+		{
+			const size_t bytes = (size_t)capacity * sizeof(T);
+			if (Resource)
+				Resource->deallocate(items, bytes, alignof(T));
+			else
+				::operator delete(items, std::align_val_t{alignof(T)});
+		}
+
+		void FreeBuffer() noexcept
+		{
+			if (IsInline())
+				return;
+			DeallocateBuffer(Items, Capacity);
+			Items = InlineItems();
+			Capacity = N;
+		}
+
+		// a buffer allocated for growth, given back when it goes out of scope unless Items was reset to nullptr
+		struct PendingBuffer
+		{
+			SmallVector* Owner;
+			u32 Capacity;
+			T* Items = Owner->AllocateBuffer(Capacity);
+			~PendingBuffer()
+			{
+				if (Items)
+					Owner->DeallocateBuffer(Items, Capacity);
+			}
+		};
+
+		void Grow(u32 needed)
+		{
+			PendingBuffer pending{this, needed > Capacity * 2 ? needed : Capacity * 2};
+			Relocate(Items, Count, pending.Items);
+			FreeBuffer();
+			Items = std::exchange(pending.Items, nullptr);
+			Capacity = pending.Capacity;
+		}
+
+		// the new element is built in the new buffer before relocating, args may refer into the old one
+		template <typename... TArgs>
+		T& GrowAndEmplace(TArgs&&... args)
+		{
+			PendingBuffer pending{this, Capacity * 2};
+			ConstructedRange item{new (pending.Items + Count) T(std::forward<TArgs>(args)...), 1};
+			Relocate(Items, Count, pending.Items);
+			item.Count = 0;
+			FreeBuffer();
+			Items = std::exchange(pending.Items, nullptr);
+			Capacity = pending.Capacity;
+			++Count;
+			return *item.First;
+		}
+
+		// other must own nothing afterwards
+		void TakeFrom(SmallVector& other) noexcept(kNothrowRelocate)
+		{
+			Resource = other.Resource;
+			if (other.IsInline())
+			{
+				Relocate<false>(other.Items, other.Count, InlineItems());
+				Items = InlineItems();
+				Capacity = N;
+			}
+			else
+			{
+				Items = other.Items;
+				Capacity = other.Capacity;
+				other.Items = other.InlineItems();
+				other.Capacity = N;
+			}
+			Count = other.Count;
+			other.Count = 0;
+		}
+
+		T* Items = InlineItems();
+		u32 Count = 0;
+		u32 Capacity = N;
+		std::pmr::memory_resource* Resource = nullptr;
+		alignas(T) byte InlineStorage[sizeof(T) * N];
+	};
+} // namespace vex
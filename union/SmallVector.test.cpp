@@ -0,0 +1,265 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for SmallVector.h, from the repository root:
+//	g++ -std=c++20 -fsanitize=address -I. union/SmallVector.test.cpp -o smallvector_test && ./smallvector_test
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "SmallVector.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using vex::SmallVector;
+
+namespace
+{
+	// counts live instances, catches double destruction and leaks through the relocating paths
+	struct Tracked
+	{
+		static inline int sLive = 0;
+		Tracked(int value = 0) : Value(std::to_string(value)) { ++sLive; }
+		Tracked(const Tracked& other) : Value(other.Value) { ++sLive; }
+		Tracked(Tracked&& other) noexcept : Value(std::move(other.Value)) { ++sLive; }
+		Tracked& operator=(const Tracked&) = default;
+		Tracked& operator=(Tracked&&) noexcept = default;
+		~Tracked() { --sLive; }
+		bool operator==(const Tracked& other) const { return Value == other.Value; }
+		std::string Value;
+	};
+
+	// a move constructor that may throw, and copies that throw on request
+	struct Fragile
+	{
+		static inline int sLive = 0;
+		static inline int sMoves = 0;
+		static inline int sCopiesLeft = -1; // the copy that finds it at 0 throws, -1 never
+
+		Fragile(int value = 0) : Value(value)
+		{
+			if (value < 0)
+				throw value;
+			++sLive;
+		}
+		Fragile(const Fragile& other) : Value(other.Value)
+		{
+			if (sCopiesLeft >= 0 && sCopiesLeft-- == 0)
+				throw other.Value;
+			++sLive;
+		}
+		Fragile(Fragile&& other) : Value(other.Value)
+		{
+			++sMoves;
+			++sLive;
+		}
+		Fragile& operator=(const Fragile&) = default;
+		~Fragile() { --sLive; }
+		bool operator==(const Tracked& other) const { return std::to_string(Value) == other.Value; }
+		int Value;
+	};
+
+	// counts bytes handed out so a test can see which buffers came from it
+	struct CountingResource : std::pmr::memory_resource
+	{
+		size_t Outstanding = 0;
+		size_t Allocations = 0;
+
+	private:
+		void* do_allocate(size_t bytes, size_t align) override
+		{
+			Outstanding += bytes;
+			++Allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, align);
+		}
+		void do_deallocate(void* ptr, size_t bytes, size_t align) override
+		{
+			Outstanding -= bytes;
+			std::pmr::new_delete_resource()->deallocate(ptr, bytes, align);
+		}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	template <typename TVector>
+	bool Holds(const TVector& vector, std::vector<int> expected)
+	{
+		if (vector.Size() != expected.size())
+			return false;
+		for (u32 i = 0; i < vector.Size(); ++i)
+		{
+			if (!(vector[i] == Tracked(expected[i])))
+				return false;
+		}
+		return true;
+	}
+
+	template <typename T>
+	void CheckGrowth()
+	{
+		SmallVector<T, 4> values;
+		for (int i = 0; i < 4; ++i)
+			values.EmplaceBack(i);
+		VEX_CHECK(values.IsInline() && values.GetCapacity() == 4);
+		// the argument lives in the buffer being replaced
+		values.PushBack(values[0]);
+		VEX_CHECK(!values.IsInline() && values.GetCapacity() == 8);
+		values.Insert(1, values[4]);
+		values.Emplace(6, 9);
+		VEX_CHECK(Holds(values, {0, 0, 1, 2, 3, 0, 9}));
+
+		values.Erase(1, 3);
+		values.EraseSwapBack(0);
+		values.PopBack();
+		VEX_CHECK(Holds(values, {9, 2, 3}));
+		values.Resize(6, T(5));
+		values.Resize(5);
+		VEX_CHECK(Holds(values, {9, 2, 3, 5, 5}));
+	}
+
+	void CheckCopyAndMove()
+	{
+		{
+			SmallVector<Tracked, 2> small = {1, 2};
+			SmallVector<Tracked, 2> large = {1, 2, 3, 4};
+			SmallVector<Tracked, 2> copy = large;
+			VEX_CHECK(copy == large && copy != small);
+			copy = small;
+			VEX_CHECK(copy == small);
+
+			// an inline source is relocated element by element, a heap source hands over its buffer
+			const Tracked* heapItems = large.Data();
+			SmallVector<Tracked, 2> movedSmall = std::move(small);
+			SmallVector<Tracked, 2> movedLarge = std::move(large);
+			VEX_CHECK(movedSmall.IsInline() && Holds(movedSmall, {1, 2}) && small.IsEmpty());
+			VEX_CHECK(movedLarge.Data() == heapItems && large.IsEmpty() && large.IsInline());
+
+			movedSmall = std::move(movedLarge);
+			VEX_CHECK(Holds(movedSmall, {1, 2, 3, 4}) && movedSmall.Data() == heapItems);
+			movedSmall = movedSmall;
+			VEX_CHECK(movedSmall.Size() == 4);
+		}
+		VEX_CHECK(Tracked::sLive == 0);
+
+		SmallVector<std::unique_ptr<int>, 1> owners;
+		for (int i = 0; i < 10; ++i)
+			owners.EmplaceBack(new int(i));
+		owners.Erase(0, 5);
+		VEX_CHECK(owners.Size() == 5 && *owners.Front() == 5 && *owners.Back() == 9);
+	}
+
+	void CheckResource()
+	{
+		CountingResource resource;
+		{
+			SmallVector<int, 4> values(&resource);
+			for (int i = 0; i < 4; ++i)
+				values.PushBack(i);
+			VEX_CHECK(resource.Allocations == 0);
+			for (int i = 4; i < 100; ++i)
+				values.PushBack(i);
+			VEX_CHECK(resource.Allocations > 0 && resource.Outstanding == values.GetCapacity() * sizeof(int));
+
+			// the resource travels with the buffer
+			SmallVector<int, 4> moved = std::move(values);
+			SmallVector<int, 4> copy = moved;
+			VEX_CHECK(resource.Outstanding == (moved.GetCapacity() + copy.GetCapacity()) * sizeof(int));
+			VEX_CHECK(copy[99] == 99);
+		}
+		VEX_CHECK(resource.Outstanding == 0);
+	}
+
+	// growth copies elements whose move may throw, a throw leaves the vector and the heap as they were
+	void CheckThrowingElements()
+	{
+		CountingResource resource;
+		{
+			SmallVector<Fragile, 2> values(&resource);
+			for (int i = 0; i < 5; ++i)
+				values.EmplaceBack(i);
+			VEX_CHECK(Fragile::sMoves == 0 && Holds(values, {0, 1, 2, 3, 4}));
+			const u32 capacity = values.GetCapacity();
+			const Fragile* items = values.Data();
+
+			// a copy throws half way through relocating for Reserve
+			Fragile::sCopiesLeft = 2;
+			int thrown = -1;
+			try
+			{
+				values.Reserve(64);
+			}
+			catch (int value)
+			{
+				thrown = value;
+			}
+			Fragile::sCopiesLeft = -1;
+			VEX_CHECK(thrown == 2 && values.Data() == items && values.GetCapacity() == capacity);
+			VEX_CHECK(Holds(values, {0, 1, 2, 3, 4}) && Fragile::sLive == 5);
+			VEX_CHECK(resource.Outstanding == capacity * sizeof(Fragile));
+
+			// the same while growing for a new element, that one is destroyed too
+			while (values.Size() < values.GetCapacity())
+				values.EmplaceBack((int)values.Size());
+			const u32 size = values.Size();
+			Fragile::sCopiesLeft = 3;
+			thrown = -1;
+			try
+			{
+				values.EmplaceBack(100);
+			}
+			catch (int value)
+			{
+				thrown = value;
+			}
+			Fragile::sCopiesLeft = -1;
+			VEX_CHECK(thrown == 3 && values.Size() == size && values.GetCapacity() == capacity);
+			VEX_CHECK(Fragile::sLive == (int)size && resource.Outstanding == capacity * sizeof(Fragile));
+
+			// the new element's own constructor throws
+			thrown = 0;
+			try
+			{
+				values.EmplaceBack(-7);
+			}
+			catch (int value)
+			{
+				thrown = value;
+			}
+			VEX_CHECK(thrown == -7 && values.Size() == size && values.Data()[size - 1].Value == (int)size - 1);
+			VEX_CHECK(Fragile::sLive == (int)size && resource.Outstanding == capacity * sizeof(Fragile));
+
+			values.EmplaceBack(100);
+			VEX_CHECK(values.Size() == size + 1 && values.Back().Value == 100 && Fragile::sMoves == 0);
+		}
+		VEX_CHECK(Fragile::sLive == 0 && resource.Outstanding == 0);
+
+		// moving the vector itself moves the elements, there is nothing to keep
+		{
+			SmallVector<Fragile, 4> values = {1, 2, 3};
+			SmallVector<Fragile, 4> moved = std::move(values);
+			VEX_CHECK(Fragile::sMoves == 3 && Holds(moved, {1, 2, 3}) && values.IsEmpty());
+		}
+		VEX_CHECK(Fragile::sLive == 0);
+		static_assert(!std::is_nothrow_move_constructible_v<SmallVector<Fragile, 4>>);
+		static_assert(std::is_nothrow_move_constructible_v<SmallVector<Tracked, 4>>);
+	}
+} // namespace
+
+int main()
+{
+	CheckGrowth<int>();
+	CheckGrowth<Tracked>();
+	VEX_CHECK(Tracked::sLive == 0);
+	CheckCopyAndMove();
+	CheckResource();
+	CheckThrowingElements();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -0,0 +1,199 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "CoreTemplates.h"
+#include "HashUtils.h"
+
+namespace vex
+{
+	// string -> dense 32 bit id, id -> stable string_view. string bytes live in chunked bump storage
+	// that never moves, each one null terminated. once interned, equality is an id compare and the
+	// hash is cached (HashOf). no erase: ids stay valid for the interner's lifetime.
+	// not internally synchronized: bulk load from one thread, then every const member
+	// (Find, View, CStr, HashOf) is safe to call from any number of threads without locks.
+	template <typename THashPolicy = util::SHash_MURMUR>
+	struct TStringInterner
+	{
+		static constexpr u32 kInvalidId = 0xffffffffu;
+
+		TStringInterner() = default;
+		explicit TStringInterner(u32 count, size_t bytes = 0) { Reserve(count, bytes); }
+		TStringInterner(const TStringInterner&) = delete;
+		TStringInterner& operator=(const TStringInterner&) = delete;
+		TStringInterner(TStringInterner&& other) noexcept { Swap(other); }
+		TStringInterner& operator=(TStringInterner&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Clear();
+				Swap(other);
+			}
+			return *this;
+		}
+
+		u32 Count() const noexcept { return (u32)Views.size(); }
+		bool IsEmpty() const noexcept { return Views.empty(); }
+
+		// id of str, adding a copy of it if it is new
+		u32 Intern(std::string_view str)
+		{
+			if (!Capacity)
+				Rehash(kMinCapacity);
+			const u32 hash = HashString(str);
+			u32 slot = FindSlot(str, hash);
+			if (Slots[slot].Id != kInvalidId)
+				return Slots[slot].Id;
+
+			if (Views.size() + 1 > MaxLoad(Capacity))
+			{
+				Rehash(Capacity * 2);
+				slot = FindSlot(str, hash);
+			}
+
+			const u32 id = (u32)Views.size();
+			Views.push_back(Store(str));
+			Hashes.push_back(hash);
+			Slots[slot] = Slot{hash, id};
+			return id;
+		}
+
+		// ids[i] = Intern(strings[i]), table and storage grown once up front
+		void InternAll(std::span<const std::string_view> strings, std::span<u32> ids)
+		{
+			size_t bytes = 0;
+			for (const std::string_view str : strings)
+				bytes += str.size() + 1;
+			Reserve(Count() + (u32)strings.size(), bytes);
+			for (size_t i = 0; i < strings.size(); ++i)
+				ids[i] = Intern(strings[i]);
+		}
+
+		// kInvalidId when str was never interned
+		u32 Find(std::string_view str) const
+		{
+			if (!Capacity)
+				return kInvalidId;
+			return Slots[FindSlot(str, HashString(str))].Id;
+		}
+		bool Contains(std::string_view str) const { return Find(str) != kInvalidId; }
+
+		std::string_view View(u32 id) const { return Views[id]; }
+		const char* CStr(u32 id) const { return Views[id].data(); }
+		// THashPolicy hash of the string, computed once at intern time
+		u32 HashOf(u32 id) const { return Hashes[id]; }
+
+		void Reserve(u32 count, size_t bytes = 0)
+		{
+			Views.reserve(count);
+			Hashes.reserve(count);
+			u32 capacity = Capacity ? Capacity : kMinCapacity;
+			while (MaxLoad(capacity) < count)
+				capacity *= 2;
+			if (capacity > Capacity)
+				Rehash(capacity);
+			if (bytes > (size_t)(ChunkEnd - ChunkCursor))
+				NewChunk(bytes);
+		}
+
+		void Clear()
+		{
+			Views.clear();
+			Hashes.clear();
+			Chunks.clear();
+			ChunkCursor = ChunkEnd = nullptr;
+			Slots.reset();
+			Capacity = 0;
+		}
+
+		void Swap(TStringInterner& other) noexcept
+		{
+			std::swap(Views, other.Views);
+			std::swap(Hashes, other.Hashes);
+			std::swap(Chunks, other.Chunks);
+			std::swap(ChunkCursor, other.ChunkCursor);
+			std::swap(ChunkEnd, other.ChunkEnd);
+			std::swap(Slots, other.Slots);
+			std::swap(Capacity, other.Capacity);
+		}
+
+	private:
+		struct Slot
+		{
+			u32 Hash = 0;
+			u32 Id = kInvalidId;
+		};
+
+		static constexpr u32 kMinCapacity = 64;
+		static constexpr size_t kChunkSize = 64 * 1024;
+
+		static u32 HashString(std::string_view str) { return (u32)THashPolicy::Hash(str); }
+		// linear probing stays short below 3/4
+		static u32 MaxLoad(u32 capacity) { return capacity - capacity / 4; }
+
+		// slot holding str, or the empty slot it would be inserted into. Capacity must be non zero
+		u32 FindSlot(std::string_view str, u32 hash) const
+		{
+			const u32 mask = Capacity - 1;
+			for (u32 slot = hash & mask;; slot = (slot + 1) & mask)
+			{
+				const Slot& candidate = Slots[slot];
+				if (candidate.Id == kInvalidId || (candidate.Hash == hash && Views[candidate.Id] == str))
+					return slot;
+			}
+		}
+
+		void Rehash(u32 capacity)
+		{
+			std::unique_ptr<Slot[]> slots(new Slot[capacity]);
+			const u32 mask = capacity - 1;
+			for (u32 id = 0; id < (u32)Views.size(); ++id)
+			{
+				u32 slot = Hashes[id] & mask;
+				while (slots[slot].Id != kInvalidId)
+					slot = (slot + 1) & mask;
+				slots[slot] = Slot{Hashes[id], id};
+			}
+			Slots = std::move(slots);
+			Capacity = capacity;
+		}
+
+		void NewChunk(size_t bytes)
+		{
+			const size_t size = bytes > kChunkSize ? bytes : kChunkSize;
+			Chunks.emplace_back(new char[size]);
+			ChunkCursor = Chunks.back().get();
+			ChunkEnd = ChunkCursor + size;
+		}
+
+		std::string_view Store(std::string_view str)
+		{
+			if (str.size() + 1 > (size_t)(ChunkEnd - ChunkCursor))
+				NewChunk(str.size() + 1);
+			char* dst = ChunkCursor;
+			if (!str.empty())
+				std::memcpy(dst, str.data(), str.size());
+			dst[str.size()] = '\0';
+			ChunkCursor += str.size() + 1;
+			return std::string_view(dst, str.size());
+		}
+
+		std::vector<std::string_view> Views;
+		std::vector<u32> Hashes;
+		std::vector<std::unique_ptr<char[]>> Chunks;
+		char* ChunkCursor = nullptr;
+		char* ChunkEnd = nullptr;
+		std::unique_ptr<Slot[]> Slots;
+		u32 Capacity = 0;
+	};
+
+	using StringInterner = TStringInterner<>;
+} // namespace vex
@@ -0,0 +1,113 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for StringInterner.h, from the repository root:
+//	g++ -std=c++20 -I. union/StringInterner.test.cpp -o stringinterner_test && ./stringinterner_test
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "StringInterner.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+namespace
+{
+	// every string in one probe chain
+	struct SameHash
+	{
+		static constexpr int Hash(std::string_view) { return 7; }
+	};
+
+	template <typename TInterner>
+	void CheckDenseAndStable(TInterner& interner, u32 count)
+	{
+		std::vector<std::string> strings;
+		for (u32 i = 0; i < count; ++i)
+			strings.push_back("name_" + std::to_string(i * 7919));
+
+		// views taken early must survive the table and storage growing behind them
+		const u32 first = interner.Intern(strings[0]);
+		const char* firstData = interner.CStr(first);
+
+		u32 dense = 0;
+		for (u32 i = 0; i < count; ++i)
+			dense += interner.Intern(strings[i]) == i;
+		VEX_CHECK(dense == count);
+		VEX_CHECK(interner.Count() == count);
+
+		u32 matching = 0;
+		for (u32 i = 0; i < count; ++i)
+		{
+			matching += interner.Intern(strings[i]) == i && interner.Find(strings[i]) == i;
+			matching += interner.View(i) == strings[i] && std::strcmp(interner.CStr(i), strings[i].c_str()) == 0;
+		}
+		VEX_CHECK(matching == 2 * count);
+		VEX_CHECK(interner.CStr(first) == firstData);
+		VEX_CHECK(!interner.Contains("name_1"));
+	}
+
+	void CheckEdgeStrings()
+	{
+		vex::StringInterner interner;
+		VEX_CHECK(interner.Find("") == vex::StringInterner::kInvalidId);
+
+		const u32 empty = interner.Intern("");
+		VEX_CHECK(interner.View(empty).empty() && interner.CStr(empty)[0] == '\0');
+
+		// embedded nulls compare by length, not by c string
+		const std::string_view withNull("a\0b", 3);
+		const u32 a = interner.Intern("a");
+		const u32 nullId = interner.Intern(withNull);
+		VEX_CHECK(a != nullId && interner.View(nullId) == withNull);
+
+		// larger than a storage chunk
+		const std::string big(200000, 'x');
+		const u32 bigId = interner.Intern(big);
+		VEX_CHECK(interner.View(bigId) == big && interner.CStr(bigId)[big.size()] == '\0');
+		VEX_CHECK(interner.View(a) == "a");
+		VEX_CHECK(interner.HashOf(a) == (u32)vex::util::SHash_MURMUR::Hash("a"));
+	}
+
+	void CheckInternAllAndMove()
+	{
+		const std::vector<std::string_view> strings = {"red", "green", "red", "blue", "green"};
+		std::vector<u32> ids(strings.size());
+		vex::StringInterner interner;
+		interner.Intern("blue");
+		interner.InternAll(strings, ids);
+		VEX_CHECK(ids[0] == 1 && ids[1] == 2 && ids[2] == 1 && ids[3] == 0 && ids[4] == 2);
+		VEX_CHECK(interner.Count() == 3);
+
+		const char* red = interner.CStr(1);
+		vex::StringInterner moved(std::move(interner));
+		VEX_CHECK(moved.Find("red") == 1 && moved.CStr(1) == red);
+		VEX_CHECK(interner.IsEmpty() && !interner.Contains("red"));
+
+		interner = std::move(moved);
+		VEX_CHECK(interner.Find("green") == 2 && moved.IsEmpty());
+		interner.Clear();
+		VEX_CHECK(interner.IsEmpty() && interner.Intern("again") == 0);
+	}
+} // namespace
+
+int main()
+{
+	vex::StringInterner interner;
+	CheckDenseAndStable(interner, 50000);
+	vex::TStringInterner<SameHash> colliding;
+	CheckDenseAndStable(colliding, 300);
+	vex::StringInterner reserved(1000, 16000);
+	CheckDenseAndStable(reserved, 1000);
+	CheckEdgeStrings();
+	CheckInternAllAndMove();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -0,0 +1,200 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CoreTemplates.h"
+#include "Function.h"
+
+namespace vex
+{
+	// work stealing pool: every worker owns a deque, jobs submitted from a worker go to the back of
+	// its own deque and are popped LIFO (hot in cache, nested splits finish depth first), idle workers
+	// steal FIFO from the front of the others, which is where the largest pieces of a split sit.
+	// jobs submitted from outside the pool go to a shared queue every worker also drains.
+	// a job's captures live inside the queue entry (JobT), submitting never allocates once the deques
+	// have grown; captures over kJobBytes do not compile, capture a pointer to them instead.
+	struct ThreadPool
+	{
+		static constexpr size_t kJobBytes = 64;
+		using JobT = InplaceMoveFunction<void(), kJobBytes>;
+
+		static u32 DefaultWorkerCount()
+		{
+			const u32 hw = std::thread::hardware_concurrency();
+			return hw > 1 ? hw - 1 : 1; // caller thread helps while waiting
+		}
+
+		explicit ThreadPool(u32 workerCount = DefaultWorkerCount())
+		{
+			Queues.reserve(workerCount + 1);
+			for (u32 i = 0; i < workerCount + 1; ++i)
+				Queues.emplace_back(new WorkQueue);
+			Workers.reserve(workerCount);
+			for (u32 i = 0; i < workerCount; ++i)
+				Workers.emplace_back([this, i] { WorkerLoop(i); });
+		}
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> guard(SleepLock);
+				IsStopping = true;
+			}
+			Signal.notify_all();
+			for (auto& worker : Workers)
+				worker.join();
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		static ThreadPool& Global()
+		{
+			static ThreadPool pool;
+			return pool;
+		}
+
+		u32 WorkerCount() const { return (u32)Workers.size(); }
+
+		void Submit(JobT job)
+		{
+			// counted before it is visible, so QueuedCount never undercounts the queues
+			QueuedCount.fetch_add(1);
+			WorkQueue& queue = *Queues[OwnQueueIndex()];
+			{
+				std::lock_guard<std::mutex> guard(queue.Lock);
+				queue.Jobs.push_back(std::move(job));
+			}
+			if (SleepingCount.load() > 0)
+			{
+				// taking the lock orders this notify after a sleeper's last check of QueuedCount
+				std::lock_guard<std::mutex> guard(SleepLock);
+				Signal.notify_one();
+			}
+		}
+
+		// runs one queued job on the calling thread, false if there was nothing to do
+		bool RunPendingJob()
+		{
+			JobT job;
+			if (!TryPop(OwnQueueIndex(), job))
+				return false;
+			job();
+			return true;
+		}
+
+	private:
+		struct WorkQueue
+		{
+			std::mutex Lock;
+			std::deque<JobT> Jobs;
+		};
+
+		// worker threads use their own deque, every other thread the shared one at the end
+		u32 OwnQueueIndex() const { return tCurrentPool == this ? tWorkerIndex : (u32)Workers.size(); }
+
+		bool TryPop(u32 own, JobT& job)
+		{
+			if (QueuedCount.load(std::memory_order_relaxed) == 0)
+				return false;
+
+			const u32 count = (u32)Queues.size();
+			for (u32 i = 0; i < count; ++i)
+			{
+				const u32 index = (own + i) % count;
+				WorkQueue& queue = *Queues[index];
+				std::lock_guard<std::mutex> guard(queue.Lock);
+				if (queue.Jobs.empty())
+					continue;
+				if (index == own)
+				{
+					job = std::move(queue.Jobs.back());
+					queue.Jobs.pop_back();
+				}
+				else
+				{
+					job = std::move(queue.Jobs.front());
+					queue.Jobs.pop_front();
+				}
+				QueuedCount.fetch_sub(1);
+				return true;
+			}
+			return false;
+		}
+
+		void WorkerLoop(u32 index)
+		{
+			tCurrentPool = this;
+			tWorkerIndex = index;
+			for (;;)
+			{
+				JobT job;
+				if (TryPop(index, job))
+				{
+					job();
+					continue;
+				}
+
+				std::unique_lock<std::mutex> guard(SleepLock);
+				SleepingCount.fetch_add(1);
+				Signal.wait(guard, [this] { return IsStopping || QueuedCount.load() != 0; });
+				SleepingCount.fetch_sub(1);
+				if (IsStopping && QueuedCount.load() == 0)
+					return;
+			}
+		}
+
+		static inline thread_local const ThreadPool* tCurrentPool = nullptr;
+		static inline thread_local u32 tWorkerIndex = 0;
+
+		std::vector<std::unique_ptr<WorkQueue>> Queues;
+		std::atomic<u32> QueuedCount = 0;
+		std::atomic<u32> SleepingCount = 0;
+		std::mutex SleepLock;
+		std::condition_variable Signal;
+		std::vector<std::thread> Workers;
+		bool IsStopping = false;
+	};
+
+	// tracks a batch of jobs; Wait() drains the pool on the calling thread instead of blocking,
+	// so groups can be nested inside jobs without starving the workers
+	struct JobGroup
+	{
+		explicit JobGroup(ThreadPool& pool = ThreadPool::Global()) : Pool(pool) {}
+		~JobGroup() { Wait(); }
+
+		JobGroup(const JobGroup&) = delete;
+		JobGroup& operator=(const JobGroup&) = delete;
+
+		template <typename TFunc>
+		void Run(TFunc&& func)
+		{
+			Pending.fetch_add(1, std::memory_order_relaxed);
+			Pool.Submit([this, job = std::forward<TFunc>(func)]() mutable {
+				job();
+				Pending.fetch_sub(1, std::memory_order_release);
+			});
+		}
+
+		void Wait()
+		{
+			while (Pending.load(std::memory_order_acquire) != 0)
+			{
+				if (!Pool.RunPendingJob())
+					std::this_thread::yield();
+			}
+		}
+
+	private:
+		ThreadPool& Pool;
+		std::atomic<u32> Pending = 0;
+	};
+} // namespace vex
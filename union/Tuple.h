@@ -0,0 +1,435 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ * software and associated documentation files (the "Software"), to deal in the Software
+ * without restriction, including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons
+ * to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+ * BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <cstring>
+#include <utility>
+
+#include "CoreTemplates.h"
+
+namespace vex
+{
+	template <auto Index, typename TStoredType>
+	struct ValueHolder
+	{
+		template <typename T, typename U = TStoredType>
+		constexpr ValueHolder(T&& InValue) : Value{std::forward<T>(InValue)}
+		{
+		}
+
+		ValueHolder() = default;
+		ValueHolder(ValueHolder&&) = default;
+		ValueHolder(const ValueHolder&) = default;
+		ValueHolder& operator=(const ValueHolder&) = default;
+		ValueHolder& operator=(ValueHolder&&) = default;
+
+		TStoredType Value;
+	};
+
+	// reference members (Tie/Project) - assignment writes through to the referenced object
+	template <auto Index, typename TStoredType>
+	struct ValueHolder<Index, TStoredType&>
+	{
+		template <typename T>
+		constexpr ValueHolder(T&& InValue) : Value{std::forward<T>(InValue)}
+		{
+		}
+
+		ValueHolder(const ValueHolder&) = default;
+		constexpr ValueHolder& operator=(const ValueHolder& other)
+		{
+			Value = other.Value;
+			return *this;
+		}
+
+		TStoredType& Value;
+	};
+
+	struct TagType
+	{
+	};
+
+	namespace tuple_impl
+	{
+		template <typename... Types>
+		struct TupleTypeWrapper
+		{
+			template <typename T, int... N>
+			struct CreateMembers;
+
+			template <int... Number>
+			struct CreateMembers<std::integer_sequence<int, Number...>> : public ValueHolder<Number, Types>...
+			{
+				using SequenceT = std::make_integer_sequence<int, sizeof...(Types)>;
+				static constexpr auto Sq = SequenceT{};
+
+				constexpr explicit CreateMembers(Types... val) : ValueHolder<Number, Types>{val}... {}
+
+				template <typename... Others>
+				constexpr explicit CreateMembers(Others&&... val) : ValueHolder<Number, Types>{std::forward<Others>(val)}...
+				{
+				}
+				CreateMembers& operator=(const CreateMembers&) = default;
+				CreateMembers& operator=(CreateMembers&&) = default;
+				CreateMembers(const CreateMembers&) = default;
+				CreateMembers(CreateMembers&&) = default;
+				CreateMembers() = default;
+
+				template <int I>
+				constexpr auto& Get()
+				{
+					return get<I>();
+				}
+				template <int I>
+				constexpr const auto& Get() const
+				{
+					return get<I>();
+				}
+				template <typename T>
+				constexpr auto& Get()
+				{
+					constexpr auto I = meta::IndexOf<T, Types...>;
+					return get<I>();
+				}
+				template <typename T>
+				constexpr const auto& Get() const
+				{
+					constexpr auto I = meta::IndexOf<T, Types...>;
+					return get<I>();
+				}
+
+				template <int I>
+				constexpr auto& get() // support for struct bindings
+				{
+					static_assert(I < (sizeof...(Types)), "out of bounds");
+					using Target = meta::At<I, Types...>;
+					return ((static_cast<ValueHolder<I, Target>*>(this))->Value);
+				}
+				template <int I>
+				constexpr const auto& get() const // support for struct bindings,const
+				{
+					static_assert(I < (sizeof...(Types)), "out of bounds");
+					using Target = meta::At<I, Types...>;
+					return ((static_cast<const ValueHolder<I, Target>*>(this))->Value);
+				}
+			};
+			using WrappedMembers = CreateMembers<std::make_integer_sequence<int, sizeof...(Types)>>;
+			WrappedMembers Members;
+		};
+	} // namespace tuple_impl
+
+	// template <typename... Types>
+	// using TupleAlias = typename tuple_impl::TupleTypeWrapper<Types...>::WrappedMembers;
+
+	template <typename... Types>
+	struct Tuple : public tuple_impl::TupleTypeWrapper<Types...>::template CreateMembers<
+					   std::make_integer_sequence<int, sizeof...(Types)>>
+	{
+		static constexpr auto MemberCount = sizeof...(Types);
+		static_assert(MemberCount < 12, "sanity check - too many elements");
+		using Base = typename tuple_impl::TupleTypeWrapper<Types...>::WrappedMembers;
+
+		constexpr Tuple(Types... val) : Base((val)...) {}
+
+		template <typename... Others>
+		Tuple& operator=(const Tuple<Others...>& val)
+		{
+			AssignHelper<Tuple<Types...>, typename Base::SequenceT>::template SetValue(*this, val);
+			return *this;
+		}
+		template <typename Others>
+		Tuple(const Others& otherTuple) : Tuple(otherTuple, Base::Sq)
+		{
+		}
+
+		Tuple(const Tuple&) = default;
+		Tuple(Tuple&&) = default;
+		Tuple() = default;
+		~Tuple() = default;
+
+		Tuple& operator=(const Tuple&) = default;
+		Tuple& operator=(Tuple&&) = default;
+
+		template <typename... Others, int... Number>
+		Tuple(const Tuple<Others...>& otherTuple, std::integer_sequence<int, Number...> d);
+
+	private:
+		template <typename U, typename T, int... Number>
+		struct AssignHelper;
+
+		template <int... Number>
+		struct AssignHelper<Tuple<Types...>, std::integer_sequence<int, Number...>>
+		{
+			template <typename... Other>
+			static constexpr void SetValue(Tuple<Types...>& Self, const Tuple<Other...>& val) noexcept
+			{
+				(..., (((ValueHolder<Number, Types>&)(Self)).Value = ((const ValueHolder<Number, Other>&)(val)).Value));
+			}
+		};
+	};
+
+	template <typename... Tp>
+	template <typename... Others, int... Number>
+	Tuple<Tp...>::Tuple(const Tuple<Others...>& otherTuple, std::integer_sequence<int, Number...>)
+		: Base((otherTuple.template Get<Number>())...)
+	{
+	}
+
+	// placeholder for members to skip when assigning through Tie()
+	struct IgnoreType
+	{
+		template <typename T>
+		constexpr const IgnoreType& operator=(const T&) const noexcept
+		{
+			return *this;
+		}
+	};
+	inline constexpr IgnoreType Ignore{};
+
+	// tuple of references to the arguments, assignment writes straight into them:
+	// Tie(a, b) = SomeTuple; Tie(a, vex::Ignore, c) = SomeTuple;
+	template <typename... Args>
+	constexpr Tuple<Args&...> Tie(Args&... args) noexcept
+	{
+		return Tuple<Args&...>(args...);
+	}
+
+	// zero-copy view of selected members, writes through for non-const source
+	template <int... I, typename... Types>
+	constexpr auto Project(Tuple<Types...>& tuple) noexcept
+	{
+		return Tuple<std::remove_reference_t<meta::At<I, Types...>>&...>(tuple.template Get<I>()...);
+	}
+	template <int... I, typename... Types>
+	constexpr auto Project(const Tuple<Types...>& tuple) noexcept
+	{
+		return Tuple<const std::remove_reference_t<meta::At<I, Types...>>&...>(
+			tuple.template Get<I>()...);
+	}
+	template <int... I, typename... Types>
+	void Project(Tuple<Types...>&& tuple) = delete; // would dangle
+} // namespace vex
+
+namespace vex
+{
+	namespace tuple_impl
+	{
+		template <typename T>
+		struct IsTuple : std::false_type
+		{
+		};
+		template <typename... Types>
+		struct IsTuple<Tuple<Types...>> : std::true_type
+		{
+		};
+		template <typename T>
+		static constexpr bool IsTupleV = IsTuple<std::decay_t<T>>::value;
+
+		// members compared and hashed through their bytes, traits::IsByteValue or tuples made of them.
+		// every other member goes through its own ==, < and hash, a padding-free struct may still
+		// define equality on some of its fields only
+		template <typename T>
+		constexpr bool IsByteMember = traits::IsByteValue<T>;
+
+		// one memcmp (or one pass of the hash) over the whole tuple: byte members and no padding
+		template <typename... Types>
+		constexpr bool IsBytewiseComparable()
+		{
+			if constexpr (sizeof...(Types) == 0)
+				return false;
+			else
+				return (... && IsByteMember<Types>) && std::has_unique_object_representations_v<Tuple<Types...>>;
+		}
+
+		template <typename... Types>
+		constexpr bool IsByteMember<Tuple<Types...>> = IsBytewiseComparable<Types...>();
+
+		template <typename TL, typename TR, int... Number>
+		constexpr bool EqualMembers(const TL& lhs, const TR& rhs, std::integer_sequence<int, Number...>)
+		{
+			return (... && (lhs.template get<Number>() == rhs.template get<Number>()));
+		}
+
+		// first member that differs decides the order
+		template <typename TL, typename TR, int... Number>
+		constexpr bool LessMembers(const TL& lhs, const TR& rhs, std::integer_sequence<int, Number...>)
+		{
+			bool result = false;
+			(void)(... || ((lhs.template get<Number>() < rhs.template get<Number>())
+								 ? (result = true)
+								 : (rhs.template get<Number>() < lhs.template get<Number>())));
+			return result;
+		}
+	} // namespace tuple_impl
+
+	template <typename... L, typename... R>
+	constexpr bool operator==(const Tuple<L...>& lhs, const Tuple<R...>& rhs)
+	{
+		static_assert(sizeof...(L) == sizeof...(R), "cannot compare tuples of different size");
+		if constexpr ((... && std::is_same_v<L, R>) && tuple_impl::IsBytewiseComparable<L...>())
+		{
+			if (!std::is_constant_evaluated())
+				return std::memcmp(&lhs, &rhs, sizeof(lhs)) == 0;
+		}
+		return tuple_impl::EqualMembers(lhs, rhs, std::make_integer_sequence<int, sizeof...(L)>{});
+	}
+	template <typename... L, typename... R>
+	constexpr bool operator!=(const Tuple<L...>& lhs, const Tuple<R...>& rhs)
+	{
+		return !(lhs == rhs);
+	}
+
+	template <typename... L, typename... R>
+	constexpr bool operator<(const Tuple<L...>& lhs, const Tuple<R...>& rhs)
+	{
+		static_assert(sizeof...(L) == sizeof...(R), "cannot compare tuples of different size");
+		return tuple_impl::LessMembers(lhs, rhs, std::make_integer_sequence<int, sizeof...(L)>{});
+	}
+	template <typename... L, typename... R>
+	constexpr bool operator>(const Tuple<L...>& lhs, const Tuple<R...>& rhs)
+	{
+		return rhs < lhs;
+	}
+	template <typename... L, typename... R>
+	constexpr bool operator<=(const Tuple<L...>& lhs, const Tuple<R...>& rhs)
+	{
+		return !(rhs < lhs);
+	}
+	template <typename... L, typename... R>
+	constexpr bool operator>=(const Tuple<L...>& lhs, const Tuple<R...>& rhs)
+	{
+		return !(lhs < rhs);
+	}
+} // namespace vex
+
+namespace std
+{
+	template <typename... Types>
+	struct tuple_size<vex::Tuple<Types...>> : std::integral_constant<std::size_t, sizeof...(Types)>
+	{
+	};
+
+	template <std::size_t N, class... Types>
+	struct tuple_element<N, vex::Tuple<Types...>>
+	{
+		using type = vex::meta::At<N, Types...>;
+	};
+
+	template <std::size_t I, class... Types>
+	constexpr auto& get(vex::Tuple<Types...>& arg)
+	{
+		return arg.template Get<I>();
+	}
+	template <std::size_t I, class... Types>
+	constexpr const auto& get(const vex::Tuple<Types...>& arg)
+	{
+		return arg.template Get<I>();
+	}
+
+	template <std::size_t I, class... Types>
+	constexpr auto&& get(vex::Tuple<Types...>&& arg)
+	{
+		return static_cast<decltype(arg.template Get<I>())&&>(arg.template Get<I>());
+	}
+	template <std::size_t I, class... Types>
+	constexpr const auto&& get(const vex::Tuple<Types...>&& arg)
+	{
+		return static_cast<decltype(arg.template Get<I>())&&>(arg.template Get<I>());
+	}
+} // namespace std
+
+namespace vex
+{
+	namespace tuple_impl
+	{
+		// rvalue tuples hand out their members as rvalues, reference members stay lvalues
+		template <int I, typename TTuple>
+		constexpr decltype(auto) ForwardMember(TTuple&& tuple)
+		{
+			using TMember = typename std::tuple_element<I, std::decay_t<TTuple>>::type;
+			if constexpr (std::is_lvalue_reference_v<TTuple> || std::is_reference_v<TMember>)
+				return (tuple.template Get<I>());
+			else
+				return std::move(tuple.template Get<I>());
+		}
+
+		template <typename TFunc, typename TTuple, int... Number>
+		constexpr decltype(auto) ApplyImpl(TFunc&& func, TTuple&& tuple, std::integer_sequence<int, Number...>)
+		{
+			return std::forward<TFunc>(func)(ForwardMember<Number>(std::forward<TTuple>(tuple))...);
+		}
+
+		template <typename TTuple, typename TFunc, int... Number>
+		constexpr void ForEachImpl(TTuple&& tuple, TFunc& func, std::integer_sequence<int, Number...>)
+		{
+			(..., func(ForwardMember<Number>(std::forward<TTuple>(tuple))));
+		}
+
+		template <typename TTuple, typename TFunc, int... Number>
+		constexpr auto TransformImpl(TTuple&& tuple, TFunc& func, std::integer_sequence<int, Number...>)
+		{
+			// braces keep the calls in member order
+			return Tuple<std::decay_t<decltype(func(ForwardMember<Number>(std::forward<TTuple>(tuple))))>...>{
+				func(ForwardMember<Number>(std::forward<TTuple>(tuple)))...};
+		}
+
+		template <typename TTuple, typename TAcc, typename TFunc, int... Number>
+		constexpr TAcc FoldImpl(TTuple&& tuple, TAcc acc, TFunc& func, std::integer_sequence<int, Number...>)
+		{
+			(..., (acc = func(std::move(acc), ForwardMember<Number>(std::forward<TTuple>(tuple)))));
+			return acc;
+		}
+
+		template <typename TTuple>
+		using SequenceOf = std::make_integer_sequence<int, std::decay_t<TTuple>::MemberCount>;
+	} // namespace tuple_impl
+
+	// func(Get<0>(), Get<1>(), ...)
+	template <typename TFunc, typename TTuple>
+	constexpr decltype(auto) Apply(TFunc&& func, TTuple&& tuple)
+	{
+		static_assert(tuple_impl::IsTupleV<TTuple>, "Apply expects vex::Tuple");
+		return tuple_impl::ApplyImpl(
+			std::forward<TFunc>(func), std::forward<TTuple>(tuple), tuple_impl::SequenceOf<TTuple>{});
+	}
+
+	// func(member) for each member, in order
+	template <typename TTuple, typename TFunc>
+	constexpr void ForEach(TTuple&& tuple, TFunc&& func)
+	{
+		static_assert(tuple_impl::IsTupleV<TTuple>, "ForEach expects vex::Tuple");
+		tuple_impl::ForEachImpl(std::forward<TTuple>(tuple), func, tuple_impl::SequenceOf<TTuple>{});
+	}
+
+	// Tuple{func(Get<0>()), func(Get<1>()), ...}
+	template <typename TTuple, typename TFunc>
+	constexpr auto Transform(TTuple&& tuple, TFunc&& func)
+	{
+		static_assert(tuple_impl::IsTupleV<TTuple>, "Transform expects vex::Tuple");
+		return tuple_impl::TransformImpl(std::forward<TTuple>(tuple), func, tuple_impl::SequenceOf<TTuple>{});
+	}
+
+	// func(...func(func(init, Get<0>()), Get<1>())..., Get<N-1>())
+	template <typename TTuple, typename TAcc, typename TFunc>
+	constexpr TAcc Fold(TTuple&& tuple, TAcc init, TFunc&& func)
+	{
+		static_assert(tuple_impl::IsTupleV<TTuple>, "Fold expects vex::Tuple");
+		return tuple_impl::FoldImpl(std::forward<TTuple>(tuple), std::move(init), func, tuple_impl::SequenceOf<TTuple>{});
+	}
+} // namespace vex
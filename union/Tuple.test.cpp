@@ -0,0 +1,308 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// checks for Tuple.h, TupleHash.h and TupleColumns.h, from the repository root:
+//	g++ -std=c++20 -I. union/Tuple.test.cpp -o tuple_test && ./tuple_test
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "Tuple.h"
+#include "TupleColumns.h"
+#include "TupleHash.h"
+
+static int gFailures = 0;
+#define VEX_CHECK(cond) ((cond) ? (void)0 : (void)(std::printf("%s:%d: %s\n", __FILE__, __LINE__, #cond), ++gFailures))
+
+using vex::Tuple;
+
+namespace
+{
+	// no padding, but equality looks at Id only: its bytes are not its value
+	struct Key
+	{
+		int Id;
+		int Cache;
+		bool operator==(const Key& other) const { return Id == other.Id; }
+		bool operator<(const Key& other) const { return Id < other.Id; }
+	};
+
+	enum class Color : u8
+	{
+		Red,
+		Blue
+	};
+} // namespace
+
+template <>
+struct std::hash<Key>
+{
+	std::size_t operator()(const Key& key) const { return std::hash<int>{}(key.Id); }
+};
+
+namespace
+{
+	static_assert(vex::tuple_impl::IsBytewiseComparable<int, u32, const int*>());
+	static_assert(vex::tuple_impl::IsBytewiseComparable<Color, Color>());
+	static_assert(vex::tuple_impl::IsBytewiseComparable<int, Tuple<int, int>>());
+	static_assert(!vex::tuple_impl::IsBytewiseComparable<Key>());
+	static_assert(!vex::tuple_impl::IsBytewiseComparable<int, Tuple<Key, int>>());
+	static_assert(!vex::tuple_impl::IsBytewiseComparable<const char*>());
+	static_assert(!vex::tuple_impl::IsBytewiseComparable<char, int>()); // padding
+
+	// members are compared and hashed by their own rules, not by their bytes
+	void CheckMemberRule()
+	{
+		const Tuple<Key> a(Key{1, 2}), b(Key{1, 3}), c(Key{2, 2});
+		VEX_CHECK(a == b && !(a != b) && a != c);
+		VEX_CHECK(!(a < b) && !(b < a) && a < c);
+		VEX_CHECK(vex::HashTuple(a) == vex::HashTuple(b));
+		VEX_CHECK((Tuple<int, Key>(7, Key{1, 2}) == Tuple<int, Key>(7, Key{1, 5})));
+		VEX_CHECK((vex::HashTuple(Tuple<int, Tuple<Key>>(7, a)) == vex::HashTuple(Tuple<int, Tuple<Key>>(7, b))));
+
+		// char pointers are hashed by their characters, equal pointers hash equal too
+		char first[] = "abc";
+		char second[] = "abc";
+		const Tuple<const char*> byFirst((const char*)first), bySecond((const char*)second);
+		VEX_CHECK(vex::HashTuple(byFirst) == vex::HashTuple(bySecond));
+		VEX_CHECK(vex::HashTuple(byFirst) == vex::HashTuple(Tuple<std::string>(std::string("abc"))));
+		VEX_CHECK(byFirst != bySecond && byFirst == Tuple<const char*>((const char*)first));
+
+		// the byte path still gives the same answers as the member path
+		VEX_CHECK((Tuple<int, Color>(1, Color::Blue) == Tuple<int, Color>(1, Color::Blue)));
+		VEX_CHECK((Tuple<int, Color>(1, Color::Blue) != Tuple<int, Color>(1, Color::Red)));
+		VEX_CHECK((vex::HashTuple(Tuple<int, int>(1, 2)) != vex::HashTuple(Tuple<int, int>(2, 1))));
+
+		// column hashes follow the same rule
+		vex::TupleColumns<Key, const char*, int*> columns;
+		int value = 0;
+		columns.PushBack({Key{4, 0}, first, &value});
+		columns.PushBack({Key{4, 9}, second, &value});
+		u32 hashes[2];
+		vex::HashRows(columns, hashes);
+		VEX_CHECK(hashes[0] == hashes[1]);
+	}
+
+	// lexicographic over mixed member types, the same answers as std::tuple
+	void CheckOrdering()
+	{
+		using Mixed = Tuple<int, std::string, double>;
+		const int ints[] = {-1, 0, 2};
+		const char* texts[] = {"", "a", "ab", "b"};
+		const double reals[] = {-0.5, 0.0, 1.5};
+
+		std::vector<Mixed> rows;
+		std::vector<std::tuple<int, std::string, double>> expected;
+		for (const int i : ints)
+			for (const char* text : texts)
+				for (const double real : reals)
+				{
+					rows.push_back(Mixed(i, std::string(text), real));
+					expected.emplace_back(i, text, real);
+				}
+
+		u32 matching = 0;
+		for (std::size_t l = 0; l < rows.size(); ++l)
+			for (std::size_t r = 0; r < rows.size(); ++r)
+			{
+				const Mixed& lhs = rows[l];
+				const Mixed& rhs = rows[r];
+				matching += (lhs < rhs) == (expected[l] < expected[r]) && (lhs <= rhs) == (expected[l] <= expected[r]) &&
+							(lhs > rhs) == (expected[l] > expected[r]) && (lhs >= rhs) == (expected[l] >= expected[r]) &&
+							(lhs == rhs) == (l == r) && (lhs != rhs) == (l != r);
+			}
+		VEX_CHECK(matching == rows.size() * rows.size());
+
+		// an earlier member decides, whatever follows it
+		VEX_CHECK((Mixed(0, std::string("z"), 9.0) < Mixed(1, std::string(""), -9.0)));
+		VEX_CHECK((Mixed(0, std::string("a"), 9.0) < Mixed(0, std::string("b"), -9.0)));
+	}
+	static_assert(Tuple<int, double>(1, 2.0) < Tuple<int, double>(1, 2.5));
+	static_assert(!(Tuple<int, double>(1, 2.0) < Tuple<int, double>(1, 2.0)));
+	static_assert(Tuple<int, u32>(-1, 5u) < Tuple<int, u32>(0, 0u) && Tuple<int, u32>(2, 1u) == Tuple<int, u32>(2, 1u));
+
+	// equal rows hash equal, through HashTuple and through the column hashers
+	void CheckHashes()
+	{
+		using Mixed = Tuple<int, std::string, double>;
+		const Mixed a(3, std::string("text"), 0.25);
+		const Mixed b(3, std::string("te") + "xt", 0.25); // another buffer, same value
+		VEX_CHECK(a == b && vex::HashTuple(a) == vex::HashTuple(b));
+		VEX_CHECK(vex::HashTuple(a) != vex::HashTuple(Mixed(3, std::string("texts"), 0.25)));
+		VEX_CHECK((vex::HashTuple<vex::util::SHash_FNV1a>(a) == vex::HashTuple<vex::util::SHash_FNV1a>(b)));
+		VEX_CHECK(vex::TupleHash<>{}(a) == vex::TupleHash<>{}(b));
+
+		vex::TupleColumns<int, std::string, double> columns;
+		for (int i = 0; i < 64; ++i)
+			columns.PushBack(Mixed(i % 8, std::to_string(i % 4), 0.5 * (i % 2)));
+		std::vector<u32> hashes(columns.Size());
+		vex::HashRows(columns, hashes);
+
+		// row i repeats row i % 8
+		u32 matching = 0, distinct = 0;
+		for (std::size_t i = 0; i < hashes.size(); ++i)
+		{
+			matching += hashes[i] == hashes[i % 8];
+			distinct += i < 8 && i > 0 && hashes[i] != hashes[0];
+		}
+		VEX_CHECK(matching == hashes.size() && distinct == 7);
+	}
+
+	// row masks against the rows compared one by one
+	void CheckRowMasks()
+	{
+		using Row = Tuple<int, std::string>;
+		vex::TupleColumns<int, std::string> lhs, rhs;
+		for (int i = 0; i < 40; ++i)
+		{
+			lhs.PushBack(Row(i % 5, std::to_string(i % 3)));
+			rhs.PushBack(Row(i % 5, std::to_string(i % 2)));
+		}
+
+		std::vector<byte> mask(lhs.Size(), 7);
+		vex::EqualRows(lhs, rhs, mask);
+		u32 matching = 0;
+		for (std::size_t i = 0; i < mask.size(); ++i)
+			matching += mask[i] == (byte)(lhs.Row(i) == rhs.Row(i));
+		VEX_CHECK(matching == mask.size());
+
+		const Row key(2, std::string("1"));
+		vex::MatchRows(lhs, key, mask);
+		matching = 0;
+		u32 hits = 0;
+		for (std::size_t i = 0; i < mask.size(); ++i)
+		{
+			matching += mask[i] == (byte)(lhs.Row(i) == key);
+			hits += mask[i];
+		}
+		VEX_CHECK(matching == mask.size() && hits > 0);
+
+		// a short mask covers only its own rows
+		std::vector<byte> shortMask(4, 0);
+		vex::MatchRows(lhs, Row(0, std::string("0")), shortMask);
+		VEX_CHECK(shortMask[0] == 1 && shortMask[1] == 0 && shortMask[2] == 0 && shortMask[3] == 0);
+	}
+
+	// Tie and Project hold references, assignment lands in the referenced objects
+	void CheckReferences()
+	{
+		int id = 0;
+		std::string name;
+		double weight = -1.0;
+		vex::Tie(id, name, weight) = Tuple<int, std::string, double>(4, std::string("four"), 4.5);
+		VEX_CHECK(id == 4 && name == "four" && weight == 4.5);
+
+		// Ignore takes the member and drops it, the variables around it are still written
+		vex::Tie(id, vex::Ignore, weight) = Tuple<int, std::string, double>(5, std::string("five"), 5.5);
+		VEX_CHECK(id == 5 && name == "four" && weight == 5.5);
+		vex::Tie(vex::Ignore, name, vex::Ignore) = Tuple<int, std::string, double>(6, std::string("six"), 6.5);
+		VEX_CHECK(id == 5 && name == "six" && weight == 5.5);
+
+		// a tie reads the current values, too
+		const Tuple<int, std::string> copy = vex::Tie(id, name);
+		VEX_CHECK((copy == Tuple<int, std::string>(5, std::string("six"))));
+		VEX_CHECK((vex::Tie(id, name) == Tuple<int, std::string>(5, std::string("six"))));
+
+		// Project picks members by index, in any order, and writes through
+		Tuple<int, std::string, double> row(1, std::string("one"), 1.5);
+		auto view = vex::Project<2, 0>(row);
+		static_assert(std::is_same_v<decltype(view), Tuple<double&, int&>>);
+		VEX_CHECK(view.Get<0>() == 1.5 && view.Get<1>() == 1);
+		view = Tuple<double, int>(2.5, 2);
+		VEX_CHECK(row.Get<0>() == 2 && row.Get<1>() == "one" && row.Get<2>() == 2.5);
+		row.Get<0>() = 3;
+		VEX_CHECK(view.Get<1>() == 3);
+
+		// from a const tuple the view is read only
+		const Tuple<int, std::string, double>& constRow = row;
+		const auto constView = vex::Project<1>(constRow);
+		static_assert(std::is_same_v<std::remove_const_t<decltype(constView)>, Tuple<const std::string&>>);
+		VEX_CHECK(&constView.Get<0>() == &row.Get<1>());
+	}
+
+	// Transform and Fold run during compilation
+	constexpr Tuple<int, long, short> kNumbers(1, 20L, (short)300);
+	static_assert(vex::Fold(kNumbers, 0L, [](long sum, auto member) { return sum + member; }) == 321);
+	static_assert(vex::Fold(kNumbers, 0L, [](long acc, auto member) { return acc * 10 - member; }) == -600);
+	static_assert(vex::Transform(kNumbers, [](auto member) { return member * 2.0; }) == Tuple<double, double, double>(2.0, 40.0, 600.0));
+	static_assert(vex::Apply([](int a, long b, short c) { return a + b * c; }, kNumbers) == 6001);
+
+	// order of calls, value categories, and results of the member algorithms
+	void CheckAlgorithms()
+	{
+		Tuple<int, std::string, double> row(2, std::string("ab"), 0.5);
+
+		// Apply passes every member, by reference for an lvalue tuple
+		VEX_CHECK(vex::Apply([](int i, const std::string& s, double d) { return i + (int)s.size() + d; }, row) == 4.5);
+		vex::Apply([](int& i, std::string& s, double&) { ++i, s += "c"; }, row);
+		VEX_CHECK(row.Get<0>() == 3 && row.Get<1>() == "abc");
+
+		// and moves members out of an rvalue one
+		std::string moved = vex::Apply([](int, std::string&& s, double) { return std::move(s); }, std::move(row));
+		VEX_CHECK(moved == "abc");
+
+		// ForEach visits members in order and may change them
+		Tuple<int, std::string, double> other(1, std::string("x"), 2.0);
+		std::string order;
+		vex::ForEach(other, [&order](auto& member) {
+			if constexpr (std::is_same_v<std::decay_t<decltype(member)>, std::string>)
+			{
+				order += 's';
+				member += "y";
+			}
+			else
+			{
+				order += std::is_same_v<std::decay_t<decltype(member)>, int> ? 'i' : 'd';
+				member *= 3;
+			}
+		});
+		VEX_CHECK(order == "isd" && other == (Tuple<int, std::string, double>(3, std::string("xy"), 6.0)));
+
+		// Transform keeps member order and builds a tuple of the results
+		int calls = 0;
+		const auto sizes = vex::Transform(other, [&calls](const auto& member) {
+			++calls;
+			if constexpr (std::is_same_v<std::decay_t<decltype(member)>, std::string>)
+				return member.size();
+			else
+				return (std::size_t)member;
+		});
+		static_assert(std::is_same_v<std::remove_const_t<decltype(sizes)>, Tuple<std::size_t, std::size_t, std::size_t>>);
+		VEX_CHECK(calls == 3 && sizes == (Tuple<std::size_t, std::size_t, std::size_t>(3, 2, 6)));
+
+		// Fold goes left to right
+		const std::string folded = vex::Fold(other, std::string(">"), [](std::string acc, const auto& member) {
+			if constexpr (std::is_same_v<std::decay_t<decltype(member)>, std::string>)
+				return acc + member;
+			else
+				return acc + std::to_string((int)member);
+		});
+		VEX_CHECK(folded == ">3xy6");
+
+		// through a tie the algorithms reach the tied variables
+		int a = 1, b = 2;
+		vex::ForEach(vex::Tie(a, b), [](int& member) { member = -member; });
+		VEX_CHECK(a == -1 && b == -2);
+	}
+} // namespace
+
+int main()
+{
+	CheckMemberRule();
+	CheckOrdering();
+	CheckHashes();
+	CheckRowMasks();
+	CheckReferences();
+	CheckAlgorithms();
+
+	if (gFailures)
+		std::printf("%d checks failed\n", gFailures);
+	else
+		std::printf("ok\n");
+	return gFailures != 0;
+}
@@ -0,0 +1,175 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "TupleHash.h"
+
+namespace vex
+{
+	// columnar (SoA) storage of Tuple<Types...> rows, each member lives in its own contiguous column
+	template <typename... Types>
+	struct TupleColumns
+	{
+		using RowType = Tuple<Types...>;
+		using SequenceT = std::make_integer_sequence<int, sizeof...(Types)>;
+		static constexpr auto ColumnCount = sizeof...(Types);
+		static_assert(ColumnCount > 0, "columnar store needs at least one column");
+
+		template <int I>
+		auto& Column()
+		{
+			return Columns.template Get<I>();
+		}
+		template <int I>
+		const auto& Column() const
+		{
+			return Columns.template Get<I>();
+		}
+
+		std::size_t Size() const { return Columns.template Get<0>().size(); }
+
+		void Reserve(std::size_t count)
+		{
+			ForEachColumn([count](auto& column) { column.reserve(count); });
+		}
+		void Resize(std::size_t count)
+		{
+			ForEachColumn([count](auto& column) { column.resize(count); });
+		}
+		void Clear()
+		{
+			ForEachColumn([](auto& column) { column.clear(); });
+		}
+
+		void PushBack(const RowType& row) { PushBackImpl(row, SequenceT{}); }
+
+		RowType Row(std::size_t index) const { return RowImpl(index, SequenceT{}); }
+
+		Tuple<std::vector<Types>...> Columns;
+
+	private:
+		template <typename TFunc>
+		void ForEachColumn(TFunc&& func)
+		{
+			ForEachColumnImpl(func, SequenceT{});
+		}
+		template <typename TFunc, int... Number>
+		void ForEachColumnImpl(TFunc& func, std::integer_sequence<int, Number...>)
+		{
+			(..., func(Columns.template Get<Number>()));
+		}
+		template <int... Number>
+		void PushBackImpl(const RowType& row, std::integer_sequence<int, Number...>)
+		{
+			(..., Columns.template Get<Number>().push_back(row.template get<Number>()));
+		}
+		template <int... Number>
+		RowType RowImpl(std::size_t index, std::integer_sequence<int, Number...>) const
+		{
+			return RowType(Columns.template Get<Number>()[index]...);
+		}
+	};
+
+	namespace tuple_impl
+	{
+		// murmur3 fmix32 / fmix64 - branch free, so integral columns hash in a vectorizable loop
+		inline constexpr u32 MixBits(u32 k)
+		{
+			k ^= k >> 16;
+			k *= 0x85ebca6bu;
+			k ^= k >> 13;
+			k *= 0xc2b2ae35u;
+			k ^= k >> 16;
+			return k;
+		}
+		inline constexpr u32 MixBits(u64 k)
+		{
+			k ^= k >> 33;
+			k *= 0xff51afd7ed558ccdull;
+			k ^= k >> 33;
+			k *= 0xc4ceb9fe1a85ec53ull;
+			k ^= k >> 33;
+			return (u32)k;
+		}
+
+		// the same members Tuple compares by bytes, anything else is hashed like HashTuple hashes it
+		template <typename T>
+		static constexpr bool IsMixableColumn = traits::IsByteValue<T> && sizeof(T) <= 8;
+
+		template <typename THashPolicy, typename T>
+		inline void HashColumn(const std::vector<T>& column, u32* out, std::size_t count)
+		{
+			if constexpr (IsMixableColumn<T>)
+			{
+				using TBits = std::conditional_t<(sizeof(T) > 4), u64, u32>;
+				for (std::size_t i = 0; i < count; ++i)
+					out[i] = (u32)util::HashCombine((int)out[i], (int)MixBits((TBits)column[i]));
+			}
+			else
+			{
+				for (std::size_t i = 0; i < count; ++i)
+					out[i] = (u32)util::HashCombine((int)out[i], HashMember<THashPolicy>(column[i]));
+			}
+		}
+
+		template <typename T>
+		inline void EqualColumn(const std::vector<T>& lhs, const std::vector<T>& rhs, byte* mask, std::size_t count)
+		{
+			const T* l = lhs.data();
+			const T* r = rhs.data();
+			for (std::size_t i = 0; i < count; ++i)
+				mask[i] &= (byte)(l[i] == r[i]);
+		}
+
+		template <typename T>
+		inline void MatchColumn(const std::vector<T>& column, const T& key, byte* mask, std::size_t count)
+		{
+			const T* c = column.data();
+			for (std::size_t i = 0; i < count; ++i)
+				mask[i] &= (byte)(c[i] == key);
+		}
+	} // namespace tuple_impl
+
+	// out[i] = hash of row i, computed one column at a time.
+	// note: column hashes are their own family and do not match HashTuple() of the same row
+	template <typename THashPolicy = util::SHash, typename... Types>
+	inline void HashRows(const TupleColumns<Types...>& columns, std::span<u32> out)
+	{
+		const std::size_t count = out.size() < columns.Size() ? out.size() : columns.Size();
+		std::fill_n(out.data(), count, 0u);
+		[&]<int... Number>(std::integer_sequence<int, Number...>)
+		{
+			(..., tuple_impl::HashColumn<THashPolicy>(columns.template Column<Number>(), out.data(), count));
+		}(std::make_integer_sequence<int, sizeof...(Types)>{});
+	}
+
+	// mask[i] = lhs.Row(i) == rhs.Row(i)
+	template <typename... Types>
+	inline void EqualRows(const TupleColumns<Types...>& lhs, const TupleColumns<Types...>& rhs, std::span<byte> mask)
+	{
+		std::size_t count = lhs.Size() < rhs.Size() ? lhs.Size() : rhs.Size();
+		count = mask.size() < count ? mask.size() : count;
+		std::fill_n(mask.data(), count, (byte)1);
+		[&]<int... Number>(std::integer_sequence<int, Number...>)
+		{
+			(..., tuple_impl::EqualColumn(lhs.template Column<Number>(), rhs.template Column<Number>(), mask.data(), count));
+		}(std::make_integer_sequence<int, sizeof...(Types)>{});
+	}
+
+	// mask[i] = columns.Row(i) == key
+	template <typename... Types>
+	inline void MatchRows(const TupleColumns<Types...>& columns, const Tuple<Types...>& key, std::span<byte> mask)
+	{
+		const std::size_t count = mask.size() < columns.Size() ? mask.size() : columns.Size();
+		std::fill_n(mask.data(), count, (byte)1);
+		[&]<int... Number>(std::integer_sequence<int, Number...>)
+		{
+			(..., tuple_impl::MatchColumn(columns.template Column<Number>(), key.template get<Number>(), mask.data(), count));
+		}(std::make_integer_sequence<int, sizeof...(Types)>{});
+	}
+} // namespace vex
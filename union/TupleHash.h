@@ -0,0 +1,76 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <functional>
+
+#include "HashUtils.h"
+#include "Tuple.h"
+
+namespace vex
+{
+	template <typename THashPolicy = util::SHash, typename... Types>
+	int HashTuple(const Tuple<Types...>& tuple);
+
+	namespace tuple_impl
+	{
+		template <typename THashPolicy, typename T>
+		inline int HashMember(const T& value)
+		{
+			if constexpr (IsTupleV<T>)
+				return HashTuple<THashPolicy>(value);
+			else
+				return util::HashValue<THashPolicy>(value);
+		}
+
+		template <typename THashPolicy, typename TTuple, int... Number>
+		inline int HashMembers(const TTuple& tuple, std::integer_sequence<int, Number...>)
+		{
+			int hash = 0;
+			(..., (hash = util::HashCombine(hash, HashMember<THashPolicy>(tuple.template get<Number>()))));
+			return hash;
+		}
+	} // namespace tuple_impl
+
+	// tuples of integers, enums and pointers without padding are hashed in one pass over their bytes,
+	// others member by member: strings (char pointers included) by content, the rest by their own hash
+	template <typename THashPolicy, typename... Types>
+	inline int HashTuple(const Tuple<Types...>& tuple)
+	{
+		if constexpr (tuple_impl::IsBytewiseComparable<Types...>())
+			return THashPolicy::HashBytes(&tuple, sizeof(tuple));
+		else
+			return tuple_impl::HashMembers<THashPolicy>(tuple, std::make_integer_sequence<int, sizeof...(Types)>{});
+	}
+
+	// streams every member into a util::Hasher-like object, nested tuples included
+	template <typename THasher, typename... Types>
+	THasher& HashAppend(THasher& hasher, const Tuple<Types...>& tuple)
+	{
+		ForEach(tuple, [&hasher](const auto& member) {
+			using util::HashAppend;
+			HashAppend(hasher, member);
+		});
+		return hasher;
+	}
+
+	template <typename THashPolicy = util::SHash>
+	struct TupleHash
+	{
+		template <typename... Types>
+		std::size_t operator()(const Tuple<Types...>& tuple) const
+		{
+			return (u32)HashTuple<THashPolicy>(tuple);
+		}
+	};
+} // namespace vex
+
+namespace std
+{
+	template <typename... Types>
+	struct hash<vex::Tuple<Types...>>
+	{
+		std::size_t operator()(const vex::Tuple<Types...>& tuple) const { return vex::TupleHash<>{}(tuple); }
+	};
+} // namespace std
@@ -18,6 +18,11 @@
  * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <utility>
+
 #include "CoreTemplates.h"
 
 namespace vex::union_impl
@@ -26,16 +31,16 @@ namespace vex::union_impl
 	struct UnionBase
 	{
 		static_assert(sizeof...(Types) <= 7, "too many types in Union");
-		static constexpr auto SizeOfStorage = vex::memory::MaxSizeOf<Types...>();
-		static constexpr auto Alignment = vex::memory::MaxAlignOf<Types...>();
+		static constexpr auto SizeOfStorage = meta::MaxSizeOf<Types...>;
+		static constexpr auto Alignment = meta::MaxAlignOf<Types...>;
 		static constexpr auto TypeCount = sizeof...(Types);
 
-		static constexpr byte kNullVal = vex::traits::kTypeIndexNone;
+		static constexpr byte kNullVal = meta::kIndexNone;
 
 		template <typename T>
 		static constexpr size_t Id()
 		{
-			constexpr auto typeIndex = traits::GetIndex<T, Types...>();
+			constexpr auto typeIndex = meta::IndexOf<T, Types...>;
 			return typeIndex;
 		}
 
@@ -44,7 +49,7 @@ namespace vex::union_impl
 		template <typename T>
 		bool Has() const
 		{
-			constexpr auto typeIndex = traits::GetIndex<T, Types...>();
+			constexpr auto typeIndex = meta::IndexOf<T, Types...>;
 			return typeIndex == ValueIndex;
 		}
 
@@ -52,9 +57,9 @@ namespace vex::union_impl
 		T& GetUnchecked()
 		{
 			using TArg = std::remove_reference_t<T>;
-			static_assert(traits::HasType<TArg, Types...>(), "Union cannot possibly contain this type");
+			static_assert(meta::Contains<TArg, Types...>, "Union cannot possibly contain this type");
 #if !NDEBUG
-			constexpr auto typeIndex = traits::GetIndex<TArg, Types...>();
+			constexpr auto typeIndex = meta::IndexOf<TArg, Types...>;
 			if (typeIndex != this->ValueIndex)
 				std::abort();
 #endif
@@ -65,9 +70,9 @@ namespace vex::union_impl
 		const T& GetUnchecked() const
 		{
 			using TArg = std::remove_reference_t<T>;
-			static_assert(traits::HasType<TArg, Types...>(), "Union cannot possibly contain this type");
+			static_assert(meta::Contains<TArg, Types...>, "Union cannot possibly contain this type");
 #if !NDEBUG
-			constexpr auto typeIndex = traits::GetIndex<TArg, Types...>();
+			constexpr auto typeIndex = meta::IndexOf<TArg, Types...>;
 			if (typeIndex != this->ValueIndex)
 				std::abort();
 #endif
@@ -77,7 +82,7 @@ namespace vex::union_impl
 		template <typename T>
 		T* Find()
 		{
-			static_assert(traits::HasType<T, Types...>(), "Union cannot possibly contain this type");
+			static_assert(meta::Contains<T, Types...>, "Union cannot possibly contain this type");
 			if (!UnionBase::Has<T>())
 				return nullptr;
 
@@ -87,7 +92,7 @@ namespace vex::union_impl
 		template <typename T>
 		const T* Find() const
 		{
-			static_assert(traits::HasType<T, Types...>(), "Union cannot possibly contain this type");
+			static_assert(meta::Contains<T, Types...>, "Union cannot possibly contain this type");
 			if (!UnionBase::Has<T>())
 				return nullptr;
 
@@ -141,8 +146,8 @@ namespace vex::union_impl
 		template <typename T>
 		inline void SetTypeIndex()
 		{
-			static_assert(traits::HasType<T, Types...>(), "Union cannot possibly contain this type");
-			constexpr auto typeIndex = traits::GetIndex<T, Types...>();
+			static_assert(meta::Contains<T, Types...>, "Union cannot possibly contain this type");
+			constexpr auto typeIndex = meta::IndexOf<T, Types...>;
 			this->ValueIndex = typeIndex;
 		}
 	};
@@ -169,17 +174,17 @@ namespace vex::union_impl
 		UnionImpl(T&& Arg)
 		{
 			using TUnderlying = std::decay_t<T>;
-			static_assert(traits::HasType<TUnderlying, Types...>(), "Union cannot possibly contain this type");
+			static_assert(meta::Contains<TUnderlying, Types...>, "Union cannot possibly contain this type");
 
 			new (this->Storage) TUnderlying(std::forward<T>(Arg));
-			this->template SetTypeIndex<T>();
+			this->template SetTypeIndex<TUnderlying>();
 		}
 
 		template <typename T, typename TArg = T>
 		inline void Set(TArg&& Val)
 		{
 			constexpr bool kConv = std::is_convertible_v<TArg, T>; // (... || std::is_convertible_v<T, Types>);
-			static_assert(kConv || traits::HasType<TArg, Types...>(), "Union cannot possibly contain this type");
+			static_assert(kConv || meta::Contains<TArg, Types...>, "Union cannot possibly contain this type");
 
 			if (std::is_same_v<T, TArg>)
 			{
@@ -196,7 +201,7 @@ namespace vex::union_impl
 		{
 			using TUnderlying = std::decay_t<T>;
 
-			static_assert(traits::HasType<TUnderlying, Types...>(), "Union cannot possibly contain this type");
+			static_assert(meta::Contains<TUnderlying, Types...>, "Union cannot possibly contain this type");
 
 			*(reinterpret_cast<TUnderlying*>(this->Storage)) = std::forward<T>(Val);
 			this->template SetTypeIndex<T>();
@@ -206,7 +211,7 @@ namespace vex::union_impl
 		template <typename T>
 		inline T GetValueOrDefault(T defaultVal) const
 		{
-			static_assert(traits::HasType<T, Types...>(), "Union cannot possibly contain this type");
+			static_assert(meta::Contains<T, Types...>, "Union cannot possibly contain this type");
 
 			if (!this->template Has<T>())
 				return defaultVal;
@@ -218,7 +223,7 @@ namespace vex::union_impl
 		template <typename T>
 		inline T& Get()
 		{
-			static_assert(traits::HasType<T, Types...>(), "Union cannot possibly contain this type");
+			static_assert(meta::Contains<T, Types...>, "Union cannot possibly contain this type");
 			if (!this->template Has<T>())
 				this->Set(T());
 
@@ -313,7 +318,7 @@ namespace vex::union_impl
 			}
 			else
 			{
-				static_assert(traits::HasType<TUnderlying, Types...>(), "Union cannot possibly contain this type");
+				static_assert(meta::Contains<TUnderlying, Types...>, "Union cannot possibly contain this type");
 				new (this->Storage) TUnderlying(std::forward<T>(arg));
 				this->template SetTypeIndex<TUnderlying>();
 			};
@@ -325,7 +330,7 @@ namespace vex::union_impl
 		void Set(TArg&& Val)
 		{
 			constexpr bool kConv = std::is_convertible_v<TArg, TargetType>; // (... || std::is_convertible_v<T, Types>);
-			static_assert(kConv || traits::HasType<TargetType, Types...>(), // ? #todo better check
+			static_assert(kConv || meta::Contains<TargetType, Types...>, // ? #todo better check
 				"Union cannot possibly contain this type");
 
 			if constexpr (std::is_same_v<TargetType, TArg>)
@@ -0,0 +1,184 @@
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+// SpscUnionQueue and MpscUnionQueue throughput and latency, from the repository root:
+//	g++ -std=c++20 -O2 -march=native -DNDEBUG -pthread -I. union/UnionQueue.bench.cpp -o unionqueue_bench
+// throughput: every producer pushes kMessages as fast as the ring takes them, the consumer drains in batches.
+//	a mutex guarded std::vector queue of the same messages is the baseline
+// latency: every producer pushes a timestamp about every 2 us, the consumer records now - timestamp.
+// numbers from a machine with fewer cores than producers measure the scheduler more than the queue
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "UnionQueue.h"
+
+namespace
+{
+	constexpr u32 kCapacity = 4096;
+	constexpr u32 kMessages = 1 << 20;
+
+	struct Stamp
+	{
+		u64 Ns;
+	};
+	struct Payload
+	{
+		u32 Producer;
+		u32 Sequence;
+		float Values[10];
+	};
+
+	using Spsc = vex::SpscUnionQueue<kCapacity, Stamp, Payload>;
+	using Mpsc = vex::MpscUnionQueue<kCapacity, Stamp, Payload>;
+	using Message = vex::Union<Stamp, Payload>;
+
+	// the same interface over a lock, what the rings replace
+	struct MutexQueue
+	{
+		template <typename T>
+		bool TryPush(T&& value)
+		{
+			std::lock_guard<std::mutex> guard(Lock);
+			if (Items.size() == kCapacity)
+				return false;
+			Items.emplace_back(std::forward<T>(value));
+			return true;
+		}
+
+		template <typename TFunc>
+		u32 DrainN(u32 maxCount, TFunc&& func)
+		{
+			std::lock_guard<std::mutex> guard(Lock);
+			const u32 count = std::min<u32>(maxCount, (u32)Items.size());
+			for (u32 i = 0; i < count; ++i)
+				func(Items[i]);
+			Items.erase(Items.begin(), Items.begin() + count);
+			return count;
+		}
+
+		std::mutex Lock;
+		std::vector<Message> Items;
+	};
+
+	u64 NowNs()
+	{
+		return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch())
+			.count();
+	}
+
+	template <typename TQueue, typename T>
+	void Push(TQueue& queue, T&& value)
+	{
+		while (!queue.TryPush(value))
+			std::this_thread::yield();
+	}
+
+	// ns per message with all producers and the consumer running at once
+	template <typename TQueue>
+	double Throughput(u32 producers)
+	{
+		auto queue = std::make_unique<TQueue>();
+		const u32 perProducer = kMessages / producers;
+		const u64 total = (u64)perProducer * producers;
+
+		const auto start = std::chrono::steady_clock::now();
+		std::vector<std::thread> threads;
+		for (u32 p = 0; p < producers; ++p)
+		{
+			threads.emplace_back([&queue, p, perProducer] {
+				for (u32 i = 0; i < perProducer; ++i)
+					Push(*queue, Payload{p, i, {}});
+			});
+		}
+		u64 received = 0, checksum = 0;
+		while (received < total)
+		{
+			const u32 drained = queue->DrainN(256, [&](Message& message) {
+				message.template Match([&](Payload& payload) { checksum += payload.Sequence; });
+			});
+			if (!drained)
+				std::this_thread::yield();
+			received += drained;
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+		const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+		const u64 expected = (u64)perProducer * (perProducer - 1) / 2 * producers;
+		if (checksum != expected)
+			std::printf("checksum mismatch\n");
+		return elapsed.count() / (double)total;
+	}
+
+	struct Latency
+	{
+		double P50, P99, Max;
+	};
+
+	template <typename TQueue>
+	Latency PacedLatency(u32 producers)
+	{
+		constexpr u32 kPerProducer = 20000;
+		auto queue = std::make_unique<TQueue>();
+		std::vector<std::thread> threads;
+		for (u32 p = 0; p < producers; ++p)
+		{
+			threads.emplace_back([&queue] {
+				u64 next = NowNs();
+				for (u32 i = 0; i < kPerProducer; ++i)
+				{
+					while (NowNs() < next)
+						std::this_thread::yield();
+					next += 2000;
+					Push(*queue, Stamp{NowNs()});
+				}
+			});
+		}
+		std::vector<u64> samples;
+		samples.reserve((size_t)kPerProducer * producers);
+		while (samples.size() < (size_t)kPerProducer * producers)
+		{
+			const u32 drained = queue->DrainN(256, [&](Message& message) {
+				message.template Match([&](Stamp& stamp) { samples.push_back(NowNs() - stamp.Ns); });
+			});
+			if (!drained)
+				std::this_thread::yield();
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+
+		std::sort(samples.begin(), samples.end());
+		return Latency{(double)samples[samples.size() / 2], (double)samples[samples.size() * 99 / 100],
+			(double)samples.back()};
+	}
+
+	template <typename TQueue>
+	void Row(const char* name, u32 producers)
+	{
+		const double throughput = Throughput<TQueue>(producers);
+		const Latency latency = PacedLatency<TQueue>(producers);
+		std::printf("%-8s %9u %10.1f %10.1f %10.0f %10.0f %10.0f\n", name, producers, throughput, 1e3 / throughput,
+			latency.P50, latency.P99, latency.Max);
+	}
+} // namespace
+
+int main()
+{
+	std::printf("%u hardware threads\n", std::thread::hardware_concurrency());
+	std::printf("%-8s %9s %10s %10s %10s %10s %10s\n", "queue", "producers", "ns/msg", "Mmsg/s", "p50 ns", "p99 ns",
+		"max ns");
+	Row<Spsc>("spsc", 1);
+	for (u32 producers : {1u, 2u, 4u, 8u, 16u})
+	{
+		Row<Mpsc>("mpsc", producers);
+		Row<MutexQueue>("mutex", producers);
+	}
+	return 0;
+}
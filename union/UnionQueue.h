@@ -0,0 +1,245 @@
+#pragma once
+/*
+ * MIT LICENSE
+ * Copyright (c) 2019-present Vladyslav Joss
+ */
+#include <atomic>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "CoreTemplates.h"
+#include "Union.h"
+
+// bounded lock-free rings of vex::Union messages, for handing events from worker threads to a consumer
+// without a mutex. positions are 64 bit counters that never wrap, a slot is position & (Capacity - 1).
+// the consumer drains in batches and hands every message to Union Match handlers in place:
+//	MpscUnionQueue<1024, KeyEvent, MouseEvent> queue;
+//	queue.TryPush(KeyEvent{...});											any producer thread
+//	queue.Drain([](KeyEvent& e) { ... }, [](MouseEvent& e) { ... });		the consumer thread
+namespace vex
+{
+	namespace queue_impl
+	{
+		static constexpr size_t kCacheLine = 64;
+
+		template <typename TUnion, typename T>
+		inline void Store(TUnion& slot, T&& value)
+		{
+			if constexpr (std::is_same_v<std::decay_t<T>, TUnion>)
+				slot = std::forward<T>(value);
+			else
+				slot = TUnion(std::forward<T>(value));
+		}
+	} // namespace queue_impl
+
+	// one producer thread, one consumer thread. each side keeps a cached copy of the other side's
+	// index on its own cache line and only reloads it when the ring looks full (or empty)
+	template <u32 Capacity, typename... Types>
+	struct SpscUnionQueue
+	{
+		static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "queue capacity must be a power of two");
+		static constexpr u32 kCapacity = Capacity;
+		static constexpr u64 kMask = Capacity - 1;
+
+		using TUnion = Union<Types...>;
+
+		SpscUnionQueue() = default;
+		SpscUnionQueue(const SpscUnionQueue&) = delete;
+		SpscUnionQueue& operator=(const SpscUnionQueue&) = delete;
+
+		// producer: value is a TUnion or any of Types, false when the ring is full
+		template <typename T>
+		bool TryPush(T&& value)
+		{
+			const u64 tail = Tail.load(std::memory_order_relaxed);
+			if (tail - CachedHead == Capacity)
+			{
+				CachedHead = Head.load(std::memory_order_acquire);
+				if (tail - CachedHead == Capacity)
+					return false;
+			}
+			queue_impl::Store(Slots[tail & kMask], std::forward<T>(value));
+			Tail.store(tail + 1, std::memory_order_release);
+			return true;
+		}
+
+		// producer: moves a prefix of values in with one publish, returns how many went in
+		u32 TryPushN(std::span<TUnion> values)
+		{
+			const u64 tail = Tail.load(std::memory_order_relaxed);
+			if (tail + values.size() - CachedHead > Capacity)
+				CachedHead = Head.load(std::memory_order_acquire);
+			const u32 free = (u32)(Capacity - (tail - CachedHead));
+			const u32 count = values.size() < free ? (u32)values.size() : free;
+			for (u32 i = 0; i < count; ++i)
+				Slots[(tail + i) & kMask] = std::move(values[i]);
+			Tail.store(tail + count, std::memory_order_release);
+			return count;
+		}
+
+		// consumer: false when the ring is empty
+		bool TryPop(TUnion& out)
+		{
+			return DrainN(1, [&out](TUnion& message) { out = std::move(message); }) != 0;
+		}
+
+		// consumer: func(TUnion&) on up to maxCount messages in push order, the slots are handed back to the
+		// producer once the whole batch is done. returns the number of messages handled
+		template <typename TFunc>
+		u32 DrainN(u32 maxCount, TFunc&& func)
+		{
+			const u64 head = Head.load(std::memory_order_relaxed);
+			if (CachedTail - head < maxCount)
+				CachedTail = Tail.load(std::memory_order_acquire);
+			const u32 ready = (u32)(CachedTail - head);
+			const u32 count = ready < maxCount ? ready : maxCount;
+			for (u32 i = 0; i < count; ++i)
+			{
+				TUnion& slot = Slots[(head + i) & kMask];
+				func(slot);
+				slot.Reset();
+			}
+			Head.store(head + count, std::memory_order_release);
+			return count;
+		}
+
+		// consumer: MultiMatch(handlers...) on everything currently in the ring
+		template <typename... TFuncs>
+		u32 Drain(TFuncs&&... handlers)
+		{
+			return DrainN(Capacity, [&](TUnion& message) { message.MultiMatch(handlers...); });
+		}
+
+		// exact only when both sides are idle
+		u32 SizeApprox() const noexcept
+		{
+			return (u32)(Tail.load(std::memory_order_acquire) - Head.load(std::memory_order_acquire));
+		}
+
+	private:
+		alignas(queue_impl::kCacheLine) std::atomic<u64> Tail{0};
+		u64 CachedHead = 0;
+		alignas(queue_impl::kCacheLine) std::atomic<u64> Head{0};
+		u64 CachedTail = 0;
+		alignas(queue_impl::kCacheLine) TUnion Slots[Capacity];
+	};
+
+	// any number of producer threads, one consumer thread. producers claim positions with a CAS on
+	// Tail and mark each slot ready with its own sequence number, so a slow producer only holds back
+	// the messages behind its own. the consumer stops at the first slot that is not ready yet
+	template <u32 Capacity, typename... Types>
+	struct MpscUnionQueue
+	{
+		static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "queue capacity must be a power of two");
+		static constexpr u32 kCapacity = Capacity;
+		static constexpr u64 kMask = Capacity - 1;
+
+		using TUnion = Union<Types...>;
+
+		MpscUnionQueue() = default;
+		MpscUnionQueue(const MpscUnionQueue&) = delete;
+		MpscUnionQueue& operator=(const MpscUnionQueue&) = delete;
+
+		// producer: value is a TUnion or any of Types, false when the ring is full
+		template <typename T>
+		bool TryPush(T&& value)
+		{
+			u64 pos;
+			if (!Claim(1, pos))
+				return false;
+			Cell& cell = Cells[pos & kMask];
+			queue_impl::Store(cell.Value, std::forward<T>(value));
+			cell.Sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		// producer: claims one run of consecutive positions for a prefix of values, returns how many went in
+		u32 TryPushN(std::span<TUnion> values)
+		{
+			u64 pos;
+			const u32 count = Claim(values.size() < Capacity ? (u32)values.size() : Capacity, pos);
+			for (u32 i = 0; i < count; ++i)
+			{
+				Cell& cell = Cells[(pos + i) & kMask];
+				cell.Value = std::move(values[i]);
+				cell.Sequence.store(pos + i + 1, std::memory_order_release);
+			}
+			return count;
+		}
+
+		// consumer: false when the ring is empty or its oldest message is still being written
+		bool TryPop(TUnion& out)
+		{
+			return DrainN(1, [&out](TUnion& message) { out = std::move(message); }) != 0;
+		}
+
+		// consumer: func(TUnion&) on up to maxCount ready messages in claim order, the slots are handed
+		// back to the producers once the whole batch is done. returns the number of messages handled
+		template <typename TFunc>
+		u32 DrainN(u32 maxCount, TFunc&& func)
+		{
+			const u64 head = Head.load(std::memory_order_relaxed);
+			u32 count = 0;
+			for (; count < maxCount; ++count)
+			{
+				Cell& cell = Cells[(head + count) & kMask];
+				if (cell.Sequence.load(std::memory_order_acquire) != head + count + 1)
+					break;
+				func(cell.Value);
+				cell.Value.Reset();
+			}
+			if (count)
+				Head.store(head + count, std::memory_order_release);
+			return count;
+		}
+
+		// consumer: MultiMatch(handlers...) on every ready message
+		template <typename... TFuncs>
+		u32 Drain(TFuncs&&... handlers)
+		{
+			return DrainN(Capacity, [&](TUnion& message) { message.MultiMatch(handlers...); });
+		}
+
+		// claimed positions, including messages still being written
+		u32 SizeApprox() const noexcept
+		{
+			const u64 head = Head.load(std::memory_order_acquire);
+			const u64 tail = Tail.load(std::memory_order_acquire);
+			return tail > head ? (u32)(tail - head) : 0;
+		}
+
+	private:
+		// a slot is ready for the consumer at position p once Sequence == p + 1
+		struct Cell
+		{
+			std::atomic<u64> Sequence{0};
+			TUnion Value;
+		};
+
+		// reserves up to maxCount consecutive positions starting at pos, returns how many
+		u32 Claim(u32 maxCount, u64& pos)
+		{
+			pos = Tail.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				const u64 head = Head.load(std::memory_order_acquire);
+				if (head > pos) // pos is stale, the consumer has moved past it
+				{
+					pos = Tail.load(std::memory_order_relaxed);
+					continue;
+				}
+				const u32 free = (u32)(Capacity - (pos - head));
+				const u32 count = maxCount < free ? maxCount : free;
+				if (count == 0)
+					return 0;
+				if (Tail.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed))
+					return count;
+			}
+		}
+
+		alignas(queue_impl::kCacheLine) std::atomic<u64> Tail{0};
+		alignas(queue_impl::kCacheLine) std::atomic<u64> Head{0};
+		alignas(queue_impl::kCacheLine) Cell Cells[Capacity];
+	};
+} // namespace vex